@@ -0,0 +1,46 @@
+#include <argParser/ArgParser.h>
+#include <chrono>
+#include <iostream>
+
+// Measures what a shell pays on each <Tab> press with `--complete <prefix>`:
+// building a large schema and answering the completion from it
+int main()
+{
+    using Clock = std::chrono::steady_clock;
+    static constexpr int OptionCount{5000};
+    static constexpr int Runs{20};
+
+    std::string appPath{"app"};
+    std::string completeArg{"--complete"};
+    std::string prefix{"--option_42"};
+    char *argv[] = {appPath.data(), completeArg.data(), prefix.data()};
+
+    Clock::duration schemaTime{}, completionTime{};
+    std::size_t matched{0};
+    for (int run = 0; run < Runs; ++run)
+    {
+        const auto start = Clock::now();
+        ArgParser argParser{"completion benchmark"};
+        for (int i = 0; i < OptionCount; ++i)
+        {
+            const auto name = std::to_string(i);
+            argParser.addArgument("-o" + name, "--option_" + name, "option number " + name);
+        }
+        const auto built = Clock::now();
+
+        argParser.parse(3, argv);
+        matched = argParser.completionMsg().size();
+        const auto completed = Clock::now();
+
+        schemaTime += built - start;
+        completionTime += completed - built;
+    }
+
+    const auto toMicros = [](Clock::duration total)
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(total).count() / Runs;
+    };
+    std::cout << "options: " << OptionCount << ", runs: " << Runs << ", completion size: " << matched << " bytes\n"
+              << "schema build: " << toMicros(schemaTime) << " us/run\n"
+              << "--complete:   " << toMicros(completionTime) << " us/run\n";
+}
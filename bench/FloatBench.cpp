@@ -0,0 +1,70 @@
+#include <argParser/ArgParser.h>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+
+// Compares FloatParser against std::from_chars and strtod on shortest and 17 digit doubles, and on 30 digit ones
+int main()
+{
+    using Clock = std::chrono::steady_clock;
+    static constexpr int ValueCount{200000};
+    static constexpr int Runs{10};
+
+    std::mt19937_64 random{42};
+    std::uniform_real_distribution<double> magnitude{-30, 30};
+    std::vector<std::vector<std::string>> inputs(3);
+    char buffer[64];
+    for (int i = 0; i < ValueCount; ++i)
+    {
+        const auto value = std::uniform_real_distribution<double>{1, 10}(random) * std::pow(10, magnitude(random));
+        std::snprintf(buffer, sizeof(buffer), "%.6g", value);
+        inputs[0].emplace_back(buffer);
+        std::snprintf(buffer, sizeof(buffer), "%.17g", value);
+        inputs[1].emplace_back(buffer);
+        std::snprintf(buffer, sizeof(buffer), "%.29e", value);
+        inputs[2].emplace_back(buffer);
+    }
+
+    const auto measure = [](const std::vector<std::string> &texts, auto &&convert)
+    {
+        double checksum{0};
+        const auto start = Clock::now();
+        for (int run = 0; run < Runs; ++run)
+        {
+            for (const auto &text : texts)
+            {
+                checksum += convert(text);
+            }
+        }
+        const auto total = Clock::now() - start;
+        return std::make_pair(std::chrono::duration_cast<std::chrono::nanoseconds>(total).count()
+                              / (static_cast<long>(Runs) * static_cast<long>(texts.size())), checksum);
+    };
+
+    const char *names[]{"6 digits", "17 digits", "30 digits"};
+    std::cout << "values: " << ValueCount << ", runs: " << Runs << "\n";
+    for (std::size_t input = 0; input < inputs.size(); ++input)
+    {
+        const auto [parserTime, parserSum] = measure(inputs[input], [](const std::string &text)
+        {
+            double value{};
+            FloatParser::parse(text.data(), text.data() + text.size(), value);
+            return value;
+        });
+        const auto [fromCharsTime, fromCharsSum] = measure(inputs[input], [](const std::string &text)
+        {
+            double value{};
+            std::from_chars(text.data(), text.data() + text.size(), value);
+            return value;
+        });
+        const auto [strtodTime, strtodSum] = measure(inputs[input], [](const std::string &text)
+        {
+            return std::strtod(text.c_str(), nullptr);
+        });
+        std::cout << names[input] << (parserSum == fromCharsSum && parserSum == strtodSum ? "" : " (MISMATCH)")
+                  << ": FloatParser " << parserTime << " ns, std::from_chars " << fromCharsTime << " ns, strtod "
+                  << strtodTime << " ns\n";
+    }
+}
@@ -0,0 +1,51 @@
+#include <argParser/ArgParser.h>
+#include <chrono>
+#include <iostream>
+
+// Compares retrieve<std::vector<int>> of a long list against splitting the retrieved string with getline and stoi
+int main()
+{
+    using Clock = std::chrono::steady_clock;
+    static constexpr int ElementCount{50000};
+    static constexpr int Runs{100};
+
+    ArgParser argParser{"list benchmark"};
+    argParser.addArgument("-i", "--ids", "ids");
+    std::string idsArg{"--ids="};
+    for (int i = 0; i < ElementCount; ++i)
+    {
+        idsArg += (i == 0 ? "" : ",") + std::to_string(i * 7919 % 1000003);
+    }
+    std::string appPath{"app"};
+    char *argv[] = {appPath.data(), idsArg.data()};
+    argParser.parse(2, argv);
+
+    long checksum{0};
+    auto start = Clock::now();
+    for (int run = 0; run < Runs; ++run)
+    {
+        checksum += argParser.retrieve<std::vector<int>>("ids")->back();
+    }
+    const auto listTime = Clock::now() - start;
+
+    start = Clock::now();
+    for (int run = 0; run < Runs; ++run)
+    {
+        std::istringstream ids{*argParser.retrieve("ids")};
+        std::vector<int> values;
+        for (std::string id; std::getline(ids, id, ',');)
+        {
+            values.push_back(std::stoi(id));
+        }
+        checksum += values.back();
+    }
+    const auto splitTime = Clock::now() - start;
+
+    const auto toMicros = [](Clock::duration total)
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(total).count() / Runs;
+    };
+    std::cout << "elements: " << ElementCount << ", runs: " << Runs << ", checksum: " << checksum << "\n"
+              << "retrieve<std::vector<int>>: " << toMicros(listTime) << " us/run\n"
+              << "getline and stoi:           " << toMicros(splitTime) << " us/run\n";
+}
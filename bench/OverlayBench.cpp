@@ -0,0 +1,121 @@
+#include <argParser/ArgParser.h>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+namespace
+{
+std::size_t allocatedBytes{0};
+}
+
+void *operator new(std::size_t size)
+{
+    allocatedBytes += size;
+    if (void *memory = std::malloc(size))
+    {
+        return memory;
+    }
+    throw std::bad_alloc{};
+}
+
+void operator delete(void *memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void *memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+// Compares the memory and retrieval time of a copy of the parsed ArgParser per tenant, with overrides set on it,
+// against an ArgOverlay per tenant over one shared ArgParser
+int main()
+{
+    using Clock = std::chrono::steady_clock;
+    static constexpr int OptionCount{200};
+    static constexpr int TenantCount{10000};
+    static constexpr int OverridesPerTenant{3};
+
+    ArgParser base{"overlay benchmark"};
+    for (int i = 0; i < OptionCount; ++i)
+    {
+        base.addArgumentWithDefault("-o" + std::to_string(i), "--option" + std::to_string(i), "an option", i);
+    }
+    std::string appPath{"app"};
+    char *argv[] = {appPath.data()};
+    base.parse(1, argv);
+
+    const auto optionOf = [](int tenant, int override)
+    {
+        return "option" + std::to_string((tenant * 7 + override * 61) % OptionCount);
+    };
+
+    auto allocated = allocatedBytes;
+    std::vector<ArgParser> copies;
+    copies.reserve(TenantCount);
+    for (int tenant = 0; tenant < TenantCount; ++tenant)
+    {
+        auto &copy = copies.emplace_back(base);
+        for (int override = 0; override < OverridesPerTenant; ++override)
+        {
+            copy.setOverride(optionOf(tenant, override), tenant);
+        }
+    }
+    const auto copiesBytes = allocatedBytes - allocated;
+
+    allocated = allocatedBytes;
+    std::vector<ArgOverlay> overlays;
+    overlays.reserve(TenantCount);
+    for (int tenant = 0; tenant < TenantCount; ++tenant)
+    {
+        auto &overlay = overlays.emplace_back(base);
+        for (int override = 0; override < OverridesPerTenant; ++override)
+        {
+            overlay.set(optionOf(tenant, override), tenant);
+        }
+    }
+    const auto overlaysBytes = allocatedBytes - allocated;
+
+    const auto opts = [&base]()
+    {
+        std::vector<ArgParser::Opt<int>> opts;
+        for (int i = 0; i < OptionCount; ++i)
+        {
+            opts.push_back(base.optOf<int>("option" + std::to_string(i)));
+        }
+        return opts;
+    }();
+
+    long checksum{0};
+    auto start = Clock::now();
+    for (const auto &copy : copies)
+    {
+        for (const auto opt : opts)
+        {
+            checksum += *copy.retrieve(opt);
+        }
+    }
+    const auto copiesTime = Clock::now() - start;
+
+    start = Clock::now();
+    for (const auto &overlay : overlays)
+    {
+        for (const auto opt : opts)
+        {
+            checksum -= *overlay.retrieve(opt);
+        }
+    }
+    const auto overlaysTime = Clock::now() - start;
+
+    const auto toNanos = [](Clock::duration total)
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(total).count() / (TenantCount * OptionCount);
+    };
+    std::cout << "options: " << OptionCount << ", tenants: " << TenantCount << ", overrides per tenant: "
+              << OverridesPerTenant << ", checksum: " << checksum << "\n"
+              << "ArgParser copies: " << copiesBytes / 1024 << " KiB, " << toNanos(copiesTime) << " ns/retrieve\n"
+              << "ArgOverlays:      " << overlaysBytes / 1024 << " KiB, " << toNanos(overlaysTime)
+              << " ns/retrieve\n";
+}
@@ -0,0 +1,49 @@
+#include <argParser/ArgParser.h>
+#include <chrono>
+#include <iostream>
+
+// Compares registering the options of many plugins one by one against registering them with @addArguments
+int main()
+{
+    using Clock = std::chrono::steady_clock;
+    static constexpr int OptionCount{5000};
+    static constexpr int Runs{20};
+
+    std::vector<ArgParser::ArgSpec> specs;
+    specs.reserve(OptionCount);
+    for (int i = 0; i < OptionCount; ++i)
+    {
+        const auto name = std::to_string(i);
+        specs.push_back({"-o" + name, "--option_" + name, "option of plugin " + std::to_string(i % 100),
+                         std::to_string(i % 10)});
+    }
+
+    Clock::duration oneByOneTime{}, bulkTime{};
+    for (int run = 0; run < Runs; ++run)
+    {
+        auto start = Clock::now();
+        {
+            ArgParser argParser{"registration benchmark"};
+            for (const auto &spec : specs)
+            {
+                argParser.addArgumentWithDefault(spec.shortOpt, spec.longOpt, spec.helpMsg, *spec.defaultValue);
+            }
+        }
+        oneByOneTime += Clock::now() - start;
+
+        start = Clock::now();
+        {
+            ArgParser argParser{"registration benchmark"};
+            argParser.addArguments(specs);
+        }
+        bulkTime += Clock::now() - start;
+    }
+
+    const auto toMicros = [](Clock::duration total)
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(total).count() / Runs;
+    };
+    std::cout << "options: " << OptionCount << ", runs: " << Runs << "\n"
+              << "one by one:   " << toMicros(oneByOneTime) << " us/run\n"
+              << "addArguments: " << toMicros(bulkTime) << " us/run\n";
+}
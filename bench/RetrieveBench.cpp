@@ -0,0 +1,47 @@
+#include <argParser/ArgParser.h>
+#include <chrono>
+#include <iostream>
+
+// Compares retrieving values in a hot loop by name against retrieving them through handles
+int main()
+{
+    using Clock = std::chrono::steady_clock;
+    static constexpr int OptionCount{200};
+    static constexpr int Reads{1000000};
+
+    ArgParser argParser{"retrieve benchmark"};
+    std::vector<ArgParser::Opt<int>> handles;
+    std::vector<std::string> names;
+    for (int i = 0; i < OptionCount; ++i)
+    {
+        names.push_back("option_" + std::to_string(i));
+        handles.push_back(argParser.addTypedArgumentWithDefault("-o" + std::to_string(i), "--" + names.back(),
+                                                                "option number " + std::to_string(i), i));
+    }
+    std::string appPath{"app"};
+    char *argv[] = {appPath.data()};
+    argParser.parse(1, argv);
+
+    long byName{0}, byHandle{0};
+    auto start = Clock::now();
+    for (int i = 0; i < Reads; ++i)
+    {
+        byName += *argParser.retrieve<int>(names[i % OptionCount]);
+    }
+    const auto nameTime = Clock::now() - start;
+
+    start = Clock::now();
+    for (int i = 0; i < Reads; ++i)
+    {
+        byHandle += *argParser.retrieve(handles[i % OptionCount]);
+    }
+    const auto handleTime = Clock::now() - start;
+
+    const auto toNanos = [](Clock::duration total)
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(total).count() / Reads;
+    };
+    std::cout << "options: " << OptionCount << ", reads: " << Reads << ", sums: " << byName << ", " << byHandle << "\n"
+              << "by name:   " << toNanos(nameTime) << " ns/read\n"
+              << "by handle: " << toNanos(handleTime) << " ns/read\n";
+}
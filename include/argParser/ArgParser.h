@@ -2,15 +2,1276 @@
 
 #include <string>
 #include <vector>
-#include <unordered_set>
-#include <map>
 #include <exception>
+#include <stdexcept>
 #include <sstream>
 #include <optional>
 #include <charconv>
 #include <algorithm>
 #include <type_traits>
 #include <tuple>
+#include <string_view>
+#include <istream>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <chrono>
+#include <fstream>
+#include <filesystem>
+#include <iterator>
+#include <utility>
+#include <limits>
+#include <cfloat>
+#include <numeric>
+#include <cmath>
+#include <iomanip>
+#include <locale>
+#include <cstdlib>
+
+/*
+ * Exact and locale independent conversion of decimal text to float or double, same as std::from_chars with
+ * std::chars_format::general: no leading '+' or spaces, "inf", "infinity", "nan" and "nan(chars)" in any case
+ *      double value{};
+ *      const auto [ptr, ec] = FloatParser::parse(text.data(), text.data() + text.size(), value);
+ *
+ * ArgParser converts floating point values with it when the standard library has no floating point
+ * std::from_chars, or when ARG_PARSER_BUILTIN_FLOAT_PARSER is defined
+ *
+ * Most values are converted with a multiplication of doubles (Clinger's fast path) or with one or two 64x128
+ * bit multiplications by a truncated power of five (Eisel-Lemire algorithm), which are exact for up to 19
+ * significant digits. Longer values which are close to the middle of two floats are decided by comparing with
+ * that middle using big integers, so the result is always the correctly rounded one, as of strtod
+ * If the value is too big, or too small but not 0, to be represented, ec is std::errc::result_out_of_range and
+ * @value isn't modified
+ * */
+class FloatParser
+{
+public:
+    template<typename T>
+    static std::from_chars_result parse(const char *first, const char *last, T &value) noexcept;
+
+private:
+    // Digits of the text, without the sign
+    struct Decimal
+    {
+        // first 19 significant digits, value is @mantissa * 10^@exponent unless @truncated
+        std::uint64_t mantissa{0};
+        std::int64_t exponent{0};
+
+        // if there are non zero digits after the first 19
+        bool truncated{false};
+
+        // for @truncated values, all of the digits are read again from these
+        const char *integerBegin{nullptr};
+        const char *integerEnd{nullptr};
+        const char *fractionBegin{nullptr};
+        const char *fractionEnd{nullptr};
+        std::int64_t explicitExponent{0};
+    };
+
+    // Float as it's stored: @mantissa without the implicit bit and the biased exponent @power2
+    struct Binary
+    {
+        std::uint64_t mantissa{0};
+        std::int32_t power2{0};
+
+        bool operator==(const Binary &other) const noexcept;
+        bool operator!=(const Binary &other) const noexcept;
+    };
+
+    // IEEE 754 binary32 and binary64 constants
+    template<typename T>
+    struct Format
+    {
+        static constexpr bool isDouble{std::is_same_v<T, double>};
+        using Bits = std::conditional_t<isDouble, std::uint64_t, std::uint32_t>;
+        static constexpr int mantissaBits{isDouble ? 52 : 23};
+        static constexpr int minimumExponent{isDouble ? -1023 : -127};
+        static constexpr int infinitePower{isDouble ? 0x7FF : 0xFF};
+        // product of 19 digits and 10^q has no bits below the truncated ones, only if 5^q fits in 64 bits
+        static constexpr int minExponentRoundToEven{isDouble ? -4 : -17};
+        static constexpr int maxExponentRoundToEven{isDouble ? 23 : 10};
+        // any 19 digits times a smaller power is rounded to 0, and times a bigger power to infinity
+        static constexpr int smallestPowerOfTen{isDouble ? -342 : -65};
+        static constexpr int largestPowerOfTen{isDouble ? 308 : 38};
+        // powers of ten and integers up to which both are exact in T
+        static constexpr int maxExponentFastPath{isDouble ? 22 : 10};
+        static constexpr std::uint64_t maxMantissaFastPath{2ull << mantissaBits};
+    };
+
+    // Unsigned integer with 32 bit limbs, least significant first, big enough for @compareHalfway
+    struct BigInt
+    {
+        static constexpr std::size_t capacity{128};
+        std::array<std::uint32_t, capacity> limbs{};
+        std::size_t size{0};
+
+        // this = this * @factor + @addend
+        void multiply(std::uint32_t factor, std::uint32_t addend = 0) noexcept;
+        void multiplyByPowerOfFive(std::uint64_t exponent) noexcept;
+        void shiftLeft(std::uint64_t bits) noexcept;
+        // negative, 0 or positive as of std::string::compare
+        int compare(const BigInt &other) const noexcept;
+    };
+
+    static bool isDigit(char c) noexcept;
+
+    // case insensitive
+    static bool startsWith(const char *first, const char *last, std::string_view prefix) noexcept;
+
+    // "inf", "infinity", "nan" and "nan(chars)", @ptr is after the sign
+    template<typename T>
+    static std::from_chars_result parseSpecial(const char *first, const char *ptr, const char *last, bool negative,
+                                               T &value) noexcept;
+
+    // returns the end of the number starting at @ptr, nullptr if there are no digits
+    static const char *parseDecimal(const char *ptr, const char *last, Decimal &decimal) noexcept;
+
+    // high 64 bits of the 128 bit product, low ones are stored in @low
+    static std::uint64_t multiplyHigh(std::uint64_t lhs, std::uint64_t rhs, std::uint64_t &low) noexcept;
+
+    static int leadingZeros(std::uint64_t word) noexcept;
+
+    // Eisel-Lemire: rounded @w * 10^@q, @w is at most 19 digits
+    template<typename T>
+    static Binary computeFloat(std::int64_t q, std::uint64_t w) noexcept;
+
+    // For @truncated decimals, either @candidate or the next float is the right one
+    // it decides by comparing all the digits with the exact middle of these two
+    template<typename T>
+    static Binary compareHalfway(const Decimal &decimal, Binary candidate) noexcept;
+
+    // Truncated 128 bit 5^q, normalized so that the highest bit is set, for q in [-342, 308]
+    // 5^-q are rounded up, as in the Eisel-Lemire paper, each one is 2 words, the high one first
+    static constexpr int smallestPowerOfFive{-342};
+    static const std::uint64_t powersOfFive[];
+
+    // to not go through more digits than any middle of two doubles has, rest of them only decide the ties
+    static constexpr std::int64_t maxDigits{800};
+};
+
+inline
+bool FloatParser::Binary::operator==(const Binary &other) const noexcept
+{
+    return mantissa == other.mantissa && power2 == other.power2;
+}
+
+inline
+bool FloatParser::Binary::operator!=(const Binary &other) const noexcept
+{
+    return !(*this == other);
+}
+
+inline
+void FloatParser::BigInt::multiply(std::uint32_t factor, std::uint32_t addend) noexcept
+{
+    std::uint64_t carry{addend};
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        carry += static_cast<std::uint64_t>(limbs[i]) * factor;
+        limbs[i] = static_cast<std::uint32_t>(carry);
+        carry >>= 32u;
+    }
+    if (carry != 0 && size < capacity)
+    {
+        limbs[size++] = static_cast<std::uint32_t>(carry);
+    }
+}
+
+inline
+void FloatParser::BigInt::multiplyByPowerOfFive(std::uint64_t exponent) noexcept
+{
+    static constexpr std::uint32_t powers[]{1, 5, 25, 125, 625, 3125, 15625, 78125, 390625, 1953125, 9765625,
+                                            48828125, 244140625, 1220703125};
+    for (; exponent >= 13; exponent -= 13)
+    {
+        multiply(powers[13]);
+    }
+    multiply(powers[exponent]);
+}
+
+inline
+void FloatParser::BigInt::shiftLeft(std::uint64_t bits) noexcept
+{
+    if (size == 0)
+    {
+        return;
+    }
+    const auto words = static_cast<std::size_t>(std::min<std::uint64_t>(bits / 32, capacity));
+    const auto shift = static_cast<std::uint32_t>(bits % 32);
+    const auto newSize = std::min(size + words + 1, capacity);
+    for (auto i = newSize; i-- > words;)
+    {
+        const auto source = i - words;
+        const std::uint64_t high = source < size ? limbs[source] : 0;
+        const std::uint64_t low = source > 0 && source - 1 < size ? limbs[source - 1] : 0;
+        limbs[i] = static_cast<std::uint32_t>((high << shift | low >> (32 - shift)) & 0xFFFFFFFFu);
+    }
+    std::fill(limbs.begin(), limbs.begin() + static_cast<std::ptrdiff_t>(words), 0u);
+    size = newSize;
+    while (size > 0 && limbs[size - 1] == 0)
+    {
+        --size;
+    }
+}
+
+inline
+int FloatParser::BigInt::compare(const BigInt &other) const noexcept
+{
+    if (size != other.size)
+    {
+        return size < other.size ? -1 : 1;
+    }
+    for (auto i = size; i-- > 0;)
+    {
+        if (limbs[i] != other.limbs[i])
+        {
+            return limbs[i] < other.limbs[i] ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+inline
+bool FloatParser::isDigit(char c) noexcept
+{
+    return static_cast<unsigned char>(c - '0') < 10;
+}
+
+inline
+bool FloatParser::startsWith(const char *first, const char *last, std::string_view prefix) noexcept
+{
+    if (static_cast<std::size_t>(last - first) < prefix.size())
+    {
+        return false;
+    }
+    for (const char c : prefix)
+    {
+        if ((*first++ | 0x20) != c)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+template<typename T>
+inline
+std::from_chars_result FloatParser::parse(const char *first, const char *last, T &value) noexcept
+{
+    static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>, "only float and double are supported");
+    using Format = FloatParser::Format<T>;
+
+    const bool negative = first != last && *first == '-';
+    const auto *ptr = first + negative;
+    if (ptr == last)
+    {
+        return {first, std::errc::invalid_argument};
+    }
+    if (!isDigit(*ptr) && *ptr != '.')
+    {
+        return parseSpecial(first, ptr, last, negative, value);
+    }
+
+    Decimal decimal{};
+    const auto *end = parseDecimal(ptr, last, decimal);
+    if (end == nullptr)
+    {
+        return {first, std::errc::invalid_argument};
+    }
+    if (decimal.mantissa == 0)
+    {
+        value = negative ? -T{0} : T{0};
+        return {end, std::errc{}};
+    }
+
+    // extended precision of x87 would round twice
+#if FLT_EVAL_METHOD == 0 || FLT_EVAL_METHOD == 1
+    if (!decimal.truncated && decimal.exponent >= -Format::maxExponentFastPath
+        && decimal.exponent <= Format::maxExponentFastPath && decimal.mantissa <= Format::maxMantissaFastPath)
+    {
+        static constexpr double exactPowersOfTen[]{1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                                   1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+        auto result = static_cast<T>(decimal.mantissa);
+        const auto power = static_cast<T>(exactPowersOfTen[decimal.exponent < 0 ? -decimal.exponent
+                                                                                : decimal.exponent]);
+        result = decimal.exponent < 0 ? result / power : result * power;
+        value = negative ? -result : result;
+        return {end, std::errc{}};
+    }
+#endif
+
+    auto binary = computeFloat<T>(decimal.exponent, decimal.mantissa);
+    if (decimal.truncated && binary != computeFloat<T>(decimal.exponent, decimal.mantissa + 1))
+    {
+        binary = compareHalfway<T>(decimal, binary);
+    }
+    if (binary.power2 == Format::infinitePower || (binary.power2 == 0 && binary.mantissa == 0))
+    {
+        return {end, std::errc::result_out_of_range};
+    }
+
+    auto bits = static_cast<typename Format::Bits>(binary.mantissa
+                                                   | static_cast<std::uint64_t>(binary.power2) << Format::mantissaBits);
+    bits |= static_cast<typename Format::Bits>(negative) << (sizeof(bits) * 8 - 1);
+    std::memcpy(&value, &bits, sizeof(value));
+    return {end, std::errc{}};
+}
+
+template<typename T>
+inline
+std::from_chars_result FloatParser::parseSpecial(const char *first, const char *ptr, const char *last,
+                                                 bool negative, T &value) noexcept
+{
+    if (startsWith(ptr, last, "inf"))
+    {
+        value = negative ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::infinity();
+        return {ptr + (startsWith(ptr, last, "infinity") ? 8 : 3), std::errc{}};
+    }
+    if (startsWith(ptr, last, "nan"))
+    {
+        ptr += 3;
+        // "nan(chars)" is consumed only if it's closed
+        if (ptr != last && *ptr == '(')
+        {
+            auto *close = ptr + 1;
+            while (close != last && (isDigit(*close) || *close == '_'
+                                     || static_cast<unsigned char>((*close | 0x20) - 'a') < 26))
+            {
+                ++close;
+            }
+            if (close != last && *close == ')')
+            {
+                ptr = close + 1;
+            }
+        }
+        value = negative ? -std::numeric_limits<T>::quiet_NaN() : std::numeric_limits<T>::quiet_NaN();
+        return {ptr, std::errc{}};
+    }
+    return {first, std::errc::invalid_argument};
+}
+
+inline
+const char *FloatParser::parseDecimal(const char *ptr, const char *last, Decimal &decimal) noexcept
+{
+    decimal.integerBegin = ptr;
+    while (ptr != last && isDigit(*ptr))
+    {
+        ++ptr;
+    }
+    decimal.integerEnd = decimal.fractionBegin = decimal.fractionEnd = ptr;
+    if (ptr != last && *ptr == '.')
+    {
+        decimal.fractionBegin = ++ptr;
+        while (ptr != last && isDigit(*ptr))
+        {
+            ++ptr;
+        }
+        decimal.fractionEnd = ptr;
+    }
+    if (decimal.integerBegin == decimal.integerEnd && decimal.fractionBegin == decimal.fractionEnd)
+    {
+        return nullptr;
+    }
+
+    // exponent is a part of the number only if it has digits
+    if (ptr != last && (*ptr | 0x20) == 'e')
+    {
+        auto *exponent = ptr + 1;
+        const bool negative = exponent != last && *exponent == '-';
+        exponent += exponent != last && (*exponent == '-' || *exponent == '+');
+        if (exponent != last && isDigit(*exponent))
+        {
+            for (; exponent != last && isDigit(*exponent); ++exponent)
+            {
+                // value is 0 or infinity way before this limit, and no text has this many digits
+                if (decimal.explicitExponent < (std::int64_t{1} << 40))
+                {
+                    decimal.explicitExponent = decimal.explicitExponent * 10 + (*exponent - '0');
+                }
+            }
+            decimal.explicitExponent = negative ? -decimal.explicitExponent : decimal.explicitExponent;
+            ptr = exponent;
+        }
+    }
+
+    // leading zeros aren't significant, @significant counts digits from the first non zero one
+    std::int64_t significant{0};
+    const auto readDigits = [&decimal, &significant](const char *begin, const char *end)
+    {
+        for (; begin != end; ++begin)
+        {
+            const auto digit = static_cast<std::uint64_t>(*begin - '0');
+            if (significant < 19)
+            {
+                decimal.mantissa = decimal.mantissa * 10 + digit;
+                significant += decimal.mantissa != 0;
+            }
+            else
+            {
+                ++significant;
+                decimal.truncated |= digit != 0;
+            }
+        }
+    };
+    readDigits(decimal.integerBegin, decimal.integerEnd);
+    readDigits(decimal.fractionBegin, decimal.fractionEnd);
+    decimal.exponent = decimal.explicitExponent - (decimal.fractionEnd - decimal.fractionBegin)
+                       + std::max<std::int64_t>(significant - 19, 0);
+    return ptr;
+}
+
+inline
+std::uint64_t FloatParser::multiplyHigh(std::uint64_t lhs, std::uint64_t rhs, std::uint64_t &low) noexcept
+{
+#if defined(__SIZEOF_INT128__)
+    __extension__ using Word128 = unsigned __int128;
+    const auto product = static_cast<Word128>(lhs) * rhs;
+    low = static_cast<std::uint64_t>(product);
+    return static_cast<std::uint64_t>(product >> 64u);
+#else
+    const auto lhsLow = lhs & 0xFFFFFFFFu, lhsHigh = lhs >> 32u;
+    const auto rhsLow = rhs & 0xFFFFFFFFu, rhsHigh = rhs >> 32u;
+    const auto lowLow = lhsLow * rhsLow, lowHigh = lhsLow * rhsHigh, highLow = lhsHigh * rhsLow;
+    const auto middle = (lowLow >> 32u) + (lowHigh & 0xFFFFFFFFu) + (highLow & 0xFFFFFFFFu);
+    low = (middle << 32u) | (lowLow & 0xFFFFFFFFu);
+    return lhsHigh * rhsHigh + (lowHigh >> 32u) + (highLow >> 32u) + (middle >> 32u);
+#endif
+}
+
+inline
+int FloatParser::leadingZeros(std::uint64_t word) noexcept
+{
+#if defined(__GNUC__)
+    return __builtin_clzll(word);
+#else
+    int count{0};
+    for (int shift = 32; shift > 0; shift >>= 1)
+    {
+        if ((word >> (64 - shift)) == 0)
+        {
+            count += shift;
+            word <<= static_cast<unsigned>(shift);
+        }
+    }
+    return count;
+#endif
+}
+
+template<typename T>
+inline
+FloatParser::Binary FloatParser::computeFloat(std::int64_t q, std::uint64_t w) noexcept
+{
+    using Format = FloatParser::Format<T>;
+    if (w == 0 || q < Format::smallestPowerOfTen)
+    {
+        return {};
+    }
+    if (q > Format::largestPowerOfTen)
+    {
+        return {0, Format::infinitePower};
+    }
+
+    const auto lz = leadingZeros(w);
+    w <<= static_cast<unsigned>(lz);
+
+    // implicit bit, a bit to round and a bit which might be lost by the shift below are needed
+    // the second word of the power is needed only if those bits of the product might carry from below,
+    // the first one is always enough beyond that (Mushtak and Lemire, "Fast Number Parsing Without Fallback")
+    const auto index = static_cast<std::size_t>(2 * (q - smallestPowerOfFive));
+    static constexpr std::uint64_t precisionMask{~std::uint64_t{0} >> (Format::mantissaBits + 3)};
+    std::uint64_t low{0};
+    auto high = multiplyHigh(w, powersOfFive[index], low);
+    if ((high & precisionMask) == precisionMask)
+    {
+        std::uint64_t secondLow{0};
+        const auto secondHigh = multiplyHigh(w, powersOfFive[index + 1], secondLow);
+        low += secondHigh;
+        high += secondHigh > low;
+    }
+
+    const auto upperBit = static_cast<int>(high >> 63u);
+    const auto shift = static_cast<unsigned>(upperBit + 64 - Format::mantissaBits - 3);
+    auto mantissa = high >> shift;
+    // floor(q * log2(10)) + 63
+    auto power2 = static_cast<std::int32_t>((((152170 + 65536) * q) >> 16) + 63 + upperBit - lz
+                                            - Format::minimumExponent);
+    if (power2 <= 0)
+    {
+        // subnormal, unless the rounding carries into the implicit bit
+        if (-power2 + 1 >= 64)
+        {
+            return {};
+        }
+        mantissa >>= static_cast<unsigned>(-power2 + 1);
+        mantissa += mantissa & 1u;
+        mantissa >>= 1u;
+        return {mantissa, mantissa < (std::uint64_t{1} << Format::mantissaBits) ? 0 : 1};
+    }
+
+    // exactly in the middle of two floats, only possible if no bits were truncated from the power of five
+    if (low <= 1 && q >= Format::minExponentRoundToEven && q <= Format::maxExponentRoundToEven
+        && (mantissa & 3u) == 1 && (mantissa << shift) == high)
+    {
+        mantissa &= ~std::uint64_t{1};
+    }
+    mantissa += mantissa & 1u;
+    mantissa >>= 1u;
+    if (mantissa >= (std::uint64_t{2} << Format::mantissaBits))
+    {
+        mantissa = std::uint64_t{1} << Format::mantissaBits;
+        ++power2;
+    }
+    mantissa &= ~(std::uint64_t{1} << Format::mantissaBits);
+    if (power2 >= Format::infinitePower)
+    {
+        return {0, Format::infinitePower};
+    }
+    return {mantissa, power2};
+}
+
+template<typename T>
+inline
+FloatParser::Binary FloatParser::compareHalfway(const Decimal &decimal, Binary candidate) noexcept
+{
+    using Format = FloatParser::Format<T>;
+
+    // digits * 10^exponent, where a non zero digit beyond @maxDigits makes it slightly bigger
+    BigInt digits{};
+    digits.size = 1;
+    std::int64_t taken{0}, dropped{0};
+    bool sticky{false};
+    std::uint32_t chunk{0}, chunkScale{1};
+    const auto readDigits = [&](const char *begin, const char *end)
+    {
+        for (; begin != end; ++begin)
+        {
+            const auto digit = static_cast<std::uint32_t>(*begin - '0');
+            if (taken == 0 && digit == 0)
+            {
+                continue;
+            }
+            if (taken == maxDigits)
+            {
+                ++dropped;
+                sticky |= digit != 0;
+                continue;
+            }
+            ++taken;
+            chunk = chunk * 10 + digit;
+            chunkScale *= 10;
+            if (chunkScale == 1000000000)
+            {
+                digits.multiply(chunkScale, chunk);
+                chunk = 0;
+                chunkScale = 1;
+            }
+        }
+    };
+    readDigits(decimal.integerBegin, decimal.integerEnd);
+    readDigits(decimal.fractionBegin, decimal.fractionEnd);
+    digits.multiply(chunkScale, chunk);
+    const auto exponent = decimal.explicitExponent - (decimal.fractionEnd - decimal.fractionBegin) + dropped;
+
+    // middle of the candidate and the next float is (2 * significand + 1) * 2^(exponent2 - 1)
+    const auto significand = candidate.power2 == 0 ? candidate.mantissa
+                                                   : candidate.mantissa | std::uint64_t{1} << Format::mantissaBits;
+    const std::int64_t exponent2 = (candidate.power2 == 0 ? 1 : candidate.power2) + Format::minimumExponent
+                                   - Format::mantissaBits;
+    BigInt halfway{};
+    halfway.limbs[0] = static_cast<std::uint32_t>(2 * significand + 1);
+    halfway.limbs[1] = static_cast<std::uint32_t>((2 * significand + 1) >> 32u);
+    halfway.size = halfway.limbs[1] == 0 ? 1 : 2;
+
+    // compared as digits * 5^exponent * 2^exponent against the middle, without any division
+    std::int64_t digitsPower2{0}, halfwayPower2{exponent2 - 1};
+    if (exponent >= 0)
+    {
+        digits.multiplyByPowerOfFive(static_cast<std::uint64_t>(exponent));
+        digitsPower2 = exponent;
+    }
+    else
+    {
+        halfway.multiplyByPowerOfFive(static_cast<std::uint64_t>(-exponent));
+        halfwayPower2 -= exponent;
+    }
+    if (digitsPower2 > halfwayPower2)
+    {
+        digits.shiftLeft(static_cast<std::uint64_t>(digitsPower2 - halfwayPower2));
+    }
+    else
+    {
+        halfway.shiftLeft(static_cast<std::uint64_t>(halfwayPower2 - digitsPower2));
+    }
+
+    auto order = digits.compare(halfway);
+    order = order == 0 && sticky ? 1 : order;
+    auto bits = candidate.mantissa | static_cast<std::uint64_t>(candidate.power2) << Format::mantissaBits;
+    // ties to even
+    bits += order > 0 || (order == 0 && (bits & 1u) != 0);
+    return {bits & ((std::uint64_t{1} << Format::mantissaBits) - 1),
+            static_cast<std::int32_t>(bits >> Format::mantissaBits)};
+}
+
+inline
+const std::uint64_t FloatParser::powersOfFive[]{
+        0xeef453d6923bd65aull, 0x113faa2906a13b3full,
+        0x9558b4661b6565f8ull, 0x4ac7ca59a424c507ull,
+        0xbaaee17fa23ebf76ull, 0x5d79bcf00d2df649ull,
+        0xe95a99df8ace6f53ull, 0xf4d82c2c107973dcull,
+        0x91d8a02bb6c10594ull, 0x79071b9b8a4be869ull,
+        0xb64ec836a47146f9ull, 0x9748e2826cdee284ull,
+        0xe3e27a444d8d98b7ull, 0xfd1b1b2308169b25ull,
+        0x8e6d8c6ab0787f72ull, 0xfe30f0f5e50e20f7ull,
+        0xb208ef855c969f4full, 0xbdbd2d335e51a935ull,
+        0xde8b2b66b3bc4723ull, 0xad2c788035e61382ull,
+        0x8b16fb203055ac76ull, 0x4c3bcb5021afcc31ull,
+        0xaddcb9e83c6b1793ull, 0xdf4abe242a1bbf3dull,
+        0xd953e8624b85dd78ull, 0xd71d6dad34a2af0dull,
+        0x87d4713d6f33aa6bull, 0x8672648c40e5ad68ull,
+        0xa9c98d8ccb009506ull, 0x680efdaf511f18c2ull,
+        0xd43bf0effdc0ba48ull, 0x0212bd1b2566def2ull,
+        0x84a57695fe98746dull, 0x014bb630f7604b57ull,
+        0xa5ced43b7e3e9188ull, 0x419ea3bd35385e2dull,
+        0xcf42894a5dce35eaull, 0x52064cac828675b9ull,
+        0x818995ce7aa0e1b2ull, 0x7343efebd1940993ull,
+        0xa1ebfb4219491a1full, 0x1014ebe6c5f90bf8ull,
+        0xca66fa129f9b60a6ull, 0xd41a26e077774ef6ull,
+        0xfd00b897478238d0ull, 0x8920b098955522b4ull,
+        0x9e20735e8cb16382ull, 0x55b46e5f5d5535b0ull,
+        0xc5a890362fddbc62ull, 0xeb2189f734aa831dull,
+        0xf712b443bbd52b7bull, 0xa5e9ec7501d523e4ull,
+        0x9a6bb0aa55653b2dull, 0x47b233c92125366eull,
+        0xc1069cd4eabe89f8ull, 0x999ec0bb696e840aull,
+        0xf148440a256e2c76ull, 0xc00670ea43ca250dull,
+        0x96cd2a865764dbcaull, 0x380406926a5e5728ull,
+        0xbc807527ed3e12bcull, 0xc605083704f5ecf2ull,
+        0xeba09271e88d976bull, 0xf7864a44c633682eull,
+        0x93445b8731587ea3ull, 0x7ab3ee6afbe0211dull,
+        0xb8157268fdae9e4cull, 0x5960ea05bad82964ull,
+        0xe61acf033d1a45dfull, 0x6fb92487298e33bdull,
+        0x8fd0c16206306babull, 0xa5d3b6d479f8e056ull,
+        0xb3c4f1ba87bc8696ull, 0x8f48a4899877186cull,
+        0xe0b62e2929aba83cull, 0x331acdabfe94de87ull,
+        0x8c71dcd9ba0b4925ull, 0x9ff0c08b7f1d0b14ull,
+        0xaf8e5410288e1b6full, 0x07ecf0ae5ee44dd9ull,
+        0xdb71e91432b1a24aull, 0xc9e82cd9f69d6150ull,
+        0x892731ac9faf056eull, 0xbe311c083a225cd2ull,
+        0xab70fe17c79ac6caull, 0x6dbd630a48aaf406ull,
+        0xd64d3d9db981787dull, 0x092cbbccdad5b108ull,
+        0x85f0468293f0eb4eull, 0x25bbf56008c58ea5ull,
+        0xa76c582338ed2621ull, 0xaf2af2b80af6f24eull,
+        0xd1476e2c07286faaull, 0x1af5af660db4aee1ull,
+        0x82cca4db847945caull, 0x50d98d9fc890ed4dull,
+        0xa37fce126597973cull, 0xe50ff107bab528a0ull,
+        0xcc5fc196fefd7d0cull, 0x1e53ed49a96272c8ull,
+        0xff77b1fcbebcdc4full, 0x25e8e89c13bb0f7aull,
+        0x9faacf3df73609b1ull, 0x77b191618c54e9acull,
+        0xc795830d75038c1dull, 0xd59df5b9ef6a2417ull,
+        0xf97ae3d0d2446f25ull, 0x4b0573286b44ad1dull,
+        0x9becce62836ac577ull, 0x4ee367f9430aec32ull,
+        0xc2e801fb244576d5ull, 0x229c41f793cda73full,
+        0xf3a20279ed56d48aull, 0x6b43527578c1110full,
+        0x9845418c345644d6ull, 0x830a13896b78aaa9ull,
+        0xbe5691ef416bd60cull, 0x23cc986bc656d553ull,
+        0xedec366b11c6cb8full, 0x2cbfbe86b7ec8aa8ull,
+        0x94b3a202eb1c3f39ull, 0x7bf7d71432f3d6a9ull,
+        0xb9e08a83a5e34f07ull, 0xdaf5ccd93fb0cc53ull,
+        0xe858ad248f5c22c9ull, 0xd1b3400f8f9cff68ull,
+        0x91376c36d99995beull, 0x23100809b9c21fa1ull,
+        0xb58547448ffffb2dull, 0xabd40a0c2832a78aull,
+        0xe2e69915b3fff9f9ull, 0x16c90c8f323f516cull,
+        0x8dd01fad907ffc3bull, 0xae3da7d97f6792e3ull,
+        0xb1442798f49ffb4aull, 0x99cd11cfdf41779cull,
+        0xdd95317f31c7fa1dull, 0x40405643d711d583ull,
+        0x8a7d3eef7f1cfc52ull, 0x482835ea666b2572ull,
+        0xad1c8eab5ee43b66ull, 0xda3243650005eecfull,
+        0xd863b256369d4a40ull, 0x90bed43e40076a82ull,
+        0x873e4f75e2224e68ull, 0x5a7744a6e804a291ull,
+        0xa90de3535aaae202ull, 0x711515d0a205cb36ull,
+        0xd3515c2831559a83ull, 0x0d5a5b44ca873e03ull,
+        0x8412d9991ed58091ull, 0xe858790afe9486c2ull,
+        0xa5178fff668ae0b6ull, 0x626e974dbe39a872ull,
+        0xce5d73ff402d98e3ull, 0xfb0a3d212dc8128full,
+        0x80fa687f881c7f8eull, 0x7ce66634bc9d0b99ull,
+        0xa139029f6a239f72ull, 0x1c1fffc1ebc44e80ull,
+        0xc987434744ac874eull, 0xa327ffb266b56220ull,
+        0xfbe9141915d7a922ull, 0x4bf1ff9f0062baa8ull,
+        0x9d71ac8fada6c9b5ull, 0x6f773fc3603db4a9ull,
+        0xc4ce17b399107c22ull, 0xcb550fb4384d21d3ull,
+        0xf6019da07f549b2bull, 0x7e2a53a146606a48ull,
+        0x99c102844f94e0fbull, 0x2eda7444cbfc426dull,
+        0xc0314325637a1939ull, 0xfa911155fefb5308ull,
+        0xf03d93eebc589f88ull, 0x793555ab7eba27caull,
+        0x96267c7535b763b5ull, 0x4bc1558b2f3458deull,
+        0xbbb01b9283253ca2ull, 0x9eb1aaedfb016f16ull,
+        0xea9c227723ee8bcbull, 0x465e15a979c1cadcull,
+        0x92a1958a7675175full, 0x0bfacd89ec191ec9ull,
+        0xb749faed14125d36ull, 0xcef980ec671f667bull,
+        0xe51c79a85916f484ull, 0x82b7e12780e7401aull,
+        0x8f31cc0937ae58d2ull, 0xd1b2ecb8b0908810ull,
+        0xb2fe3f0b8599ef07ull, 0x861fa7e6dcb4aa15ull,
+        0xdfbdcece67006ac9ull, 0x67a791e093e1d49aull,
+        0x8bd6a141006042bdull, 0xe0c8bb2c5c6d24e0ull,
+        0xaecc49914078536dull, 0x58fae9f773886e18ull,
+        0xda7f5bf590966848ull, 0xaf39a475506a899eull,
+        0x888f99797a5e012dull, 0x6d8406c952429603ull,
+        0xaab37fd7d8f58178ull, 0xc8e5087ba6d33b83ull,
+        0xd5605fcdcf32e1d6ull, 0xfb1e4a9a90880a64ull,
+        0x855c3be0a17fcd26ull, 0x5cf2eea09a55067full,
+        0xa6b34ad8c9dfc06full, 0xf42faa48c0ea481eull,
+        0xd0601d8efc57b08bull, 0xf13b94daf124da26ull,
+        0x823c12795db6ce57ull, 0x76c53d08d6b70858ull,
+        0xa2cb1717b52481edull, 0x54768c4b0c64ca6eull,
+        0xcb7ddcdda26da268ull, 0xa9942f5dcf7dfd09ull,
+        0xfe5d54150b090b02ull, 0xd3f93b35435d7c4cull,
+        0x9efa548d26e5a6e1ull, 0xc47bc5014a1a6dafull,
+        0xc6b8e9b0709f109aull, 0x359ab6419ca1091bull,
+        0xf867241c8cc6d4c0ull, 0xc30163d203c94b62ull,
+        0x9b407691d7fc44f8ull, 0x79e0de63425dcf1dull,
+        0xc21094364dfb5636ull, 0x985915fc12f542e4ull,
+        0xf294b943e17a2bc4ull, 0x3e6f5b7b17b2939dull,
+        0x979cf3ca6cec5b5aull, 0xa705992ceecf9c42ull,
+        0xbd8430bd08277231ull, 0x50c6ff782a838353ull,
+        0xece53cec4a314ebdull, 0xa4f8bf5635246428ull,
+        0x940f4613ae5ed136ull, 0x871b7795e136be99ull,
+        0xb913179899f68584ull, 0x28e2557b59846e3full,
+        0xe757dd7ec07426e5ull, 0x331aeada2fe589cfull,
+        0x9096ea6f3848984full, 0x3ff0d2c85def7621ull,
+        0xb4bca50b065abe63ull, 0x0fed077a756b53a9ull,
+        0xe1ebce4dc7f16dfbull, 0xd3e8495912c62894ull,
+        0x8d3360f09cf6e4bdull, 0x64712dd7abbbd95cull,
+        0xb080392cc4349decull, 0xbd8d794d96aacfb3ull,
+        0xdca04777f541c567ull, 0xecf0d7a0fc5583a0ull,
+        0x89e42caaf9491b60ull, 0xf41686c49db57244ull,
+        0xac5d37d5b79b6239ull, 0x311c2875c522ced5ull,
+        0xd77485cb25823ac7ull, 0x7d633293366b828bull,
+        0x86a8d39ef77164bcull, 0xae5dff9c02033197ull,
+        0xa8530886b54dbdebull, 0xd9f57f830283fdfcull,
+        0xd267caa862a12d66ull, 0xd072df63c324fd7bull,
+        0x8380dea93da4bc60ull, 0x4247cb9e59f71e6dull,
+        0xa46116538d0deb78ull, 0x52d9be85f074e608ull,
+        0xcd795be870516656ull, 0x67902e276c921f8bull,
+        0x806bd9714632dff6ull, 0x00ba1cd8a3db53b6ull,
+        0xa086cfcd97bf97f3ull, 0x80e8a40eccd228a4ull,
+        0xc8a883c0fdaf7df0ull, 0x6122cd128006b2cdull,
+        0xfad2a4b13d1b5d6cull, 0x796b805720085f81ull,
+        0x9cc3a6eec6311a63ull, 0xcbe3303674053bb0ull,
+        0xc3f490aa77bd60fcull, 0xbedbfc4411068a9cull,
+        0xf4f1b4d515acb93bull, 0xee92fb5515482d44ull,
+        0x991711052d8bf3c5ull, 0x751bdd152d4d1c4aull,
+        0xbf5cd54678eef0b6ull, 0xd262d45a78a0635dull,
+        0xef340a98172aace4ull, 0x86fb897116c87c34ull,
+        0x9580869f0e7aac0eull, 0xd45d35e6ae3d4da0ull,
+        0xbae0a846d2195712ull, 0x8974836059cca109ull,
+        0xe998d258869facd7ull, 0x2bd1a438703fc94bull,
+        0x91ff83775423cc06ull, 0x7b6306a34627ddcfull,
+        0xb67f6455292cbf08ull, 0x1a3bc84c17b1d542ull,
+        0xe41f3d6a7377eecaull, 0x20caba5f1d9e4a93ull,
+        0x8e938662882af53eull, 0x547eb47b7282ee9cull,
+        0xb23867fb2a35b28dull, 0xe99e619a4f23aa43ull,
+        0xdec681f9f4c31f31ull, 0x6405fa00e2ec94d4ull,
+        0x8b3c113c38f9f37eull, 0xde83bc408dd3dd04ull,
+        0xae0b158b4738705eull, 0x9624ab50b148d445ull,
+        0xd98ddaee19068c76ull, 0x3badd624dd9b0957ull,
+        0x87f8a8d4cfa417c9ull, 0xe54ca5d70a80e5d6ull,
+        0xa9f6d30a038d1dbcull, 0x5e9fcf4ccd211f4cull,
+        0xd47487cc8470652bull, 0x7647c3200069671full,
+        0x84c8d4dfd2c63f3bull, 0x29ecd9f40041e073ull,
+        0xa5fb0a17c777cf09ull, 0xf468107100525890ull,
+        0xcf79cc9db955c2ccull, 0x7182148d4066eeb4ull,
+        0x81ac1fe293d599bfull, 0xc6f14cd848405530ull,
+        0xa21727db38cb002full, 0xb8ada00e5a506a7cull,
+        0xca9cf1d206fdc03bull, 0xa6d90811f0e4851cull,
+        0xfd442e4688bd304aull, 0x908f4a166d1da663ull,
+        0x9e4a9cec15763e2eull, 0x9a598e4e043287feull,
+        0xc5dd44271ad3cdbaull, 0x40eff1e1853f29fdull,
+        0xf7549530e188c128ull, 0xd12bee59e68ef47cull,
+        0x9a94dd3e8cf578b9ull, 0x82bb74f8301958ceull,
+        0xc13a148e3032d6e7ull, 0xe36a52363c1faf01ull,
+        0xf18899b1bc3f8ca1ull, 0xdc44e6c3cb279ac1ull,
+        0x96f5600f15a7b7e5ull, 0x29ab103a5ef8c0b9ull,
+        0xbcb2b812db11a5deull, 0x7415d448f6b6f0e7ull,
+        0xebdf661791d60f56ull, 0x111b495b3464ad21ull,
+        0x936b9fcebb25c995ull, 0xcab10dd900beec34ull,
+        0xb84687c269ef3bfbull, 0x3d5d514f40eea742ull,
+        0xe65829b3046b0afaull, 0x0cb4a5a3112a5112ull,
+        0x8ff71a0fe2c2e6dcull, 0x47f0e785eaba72abull,
+        0xb3f4e093db73a093ull, 0x59ed216765690f56ull,
+        0xe0f218b8d25088b8ull, 0x306869c13ec3532cull,
+        0x8c974f7383725573ull, 0x1e414218c73a13fbull,
+        0xafbd2350644eeacfull, 0xe5d1929ef90898faull,
+        0xdbac6c247d62a583ull, 0xdf45f746b74abf39ull,
+        0x894bc396ce5da772ull, 0x6b8bba8c328eb783ull,
+        0xab9eb47c81f5114full, 0x066ea92f3f326564ull,
+        0xd686619ba27255a2ull, 0xc80a537b0efefebdull,
+        0x8613fd0145877585ull, 0xbd06742ce95f5f36ull,
+        0xa798fc4196e952e7ull, 0x2c48113823b73704ull,
+        0xd17f3b51fca3a7a0ull, 0xf75a15862ca504c5ull,
+        0x82ef85133de648c4ull, 0x9a984d73dbe722fbull,
+        0xa3ab66580d5fdaf5ull, 0xc13e60d0d2e0ebbaull,
+        0xcc963fee10b7d1b3ull, 0x318df905079926a8ull,
+        0xffbbcfe994e5c61full, 0xfdf17746497f7052ull,
+        0x9fd561f1fd0f9bd3ull, 0xfeb6ea8bedefa633ull,
+        0xc7caba6e7c5382c8ull, 0xfe64a52ee96b8fc0ull,
+        0xf9bd690a1b68637bull, 0x3dfdce7aa3c673b0ull,
+        0x9c1661a651213e2dull, 0x06bea10ca65c084eull,
+        0xc31bfa0fe5698db8ull, 0x486e494fcff30a62ull,
+        0xf3e2f893dec3f126ull, 0x5a89dba3c3efccfaull,
+        0x986ddb5c6b3a76b7ull, 0xf89629465a75e01cull,
+        0xbe89523386091465ull, 0xf6bbb397f1135823ull,
+        0xee2ba6c0678b597full, 0x746aa07ded582e2cull,
+        0x94db483840b717efull, 0xa8c2a44eb4571cdcull,
+        0xba121a4650e4ddebull, 0x92f34d62616ce413ull,
+        0xe896a0d7e51e1566ull, 0x77b020baf9c81d17ull,
+        0x915e2486ef32cd60ull, 0x0ace1474dc1d122eull,
+        0xb5b5ada8aaff80b8ull, 0x0d819992132456baull,
+        0xe3231912d5bf60e6ull, 0x10e1fff697ed6c69ull,
+        0x8df5efabc5979c8full, 0xca8d3ffa1ef463c1ull,
+        0xb1736b96b6fd83b3ull, 0xbd308ff8a6b17cb2ull,
+        0xddd0467c64bce4a0ull, 0xac7cb3f6d05ddbdeull,
+        0x8aa22c0dbef60ee4ull, 0x6bcdf07a423aa96bull,
+        0xad4ab7112eb3929dull, 0x86c16c98d2c953c6ull,
+        0xd89d64d57a607744ull, 0xe871c7bf077ba8b7ull,
+        0x87625f056c7c4a8bull, 0x11471cd764ad4972ull,
+        0xa93af6c6c79b5d2dull, 0xd598e40d3dd89bcfull,
+        0xd389b47879823479ull, 0x4aff1d108d4ec2c3ull,
+        0x843610cb4bf160cbull, 0xcedf722a585139baull,
+        0xa54394fe1eedb8feull, 0xc2974eb4ee658828ull,
+        0xce947a3da6a9273eull, 0x733d226229feea32ull,
+        0x811ccc668829b887ull, 0x0806357d5a3f525full,
+        0xa163ff802a3426a8ull, 0xca07c2dcb0cf26f7ull,
+        0xc9bcff6034c13052ull, 0xfc89b393dd02f0b5ull,
+        0xfc2c3f3841f17c67ull, 0xbbac2078d443ace2ull,
+        0x9d9ba7832936edc0ull, 0xd54b944b84aa4c0dull,
+        0xc5029163f384a931ull, 0x0a9e795e65d4df11ull,
+        0xf64335bcf065d37dull, 0x4d4617b5ff4a16d5ull,
+        0x99ea0196163fa42eull, 0x504bced1bf8e4e45ull,
+        0xc06481fb9bcf8d39ull, 0xe45ec2862f71e1d6ull,
+        0xf07da27a82c37088ull, 0x5d767327bb4e5a4cull,
+        0x964e858c91ba2655ull, 0x3a6a07f8d510f86full,
+        0xbbe226efb628afeaull, 0x890489f70a55368bull,
+        0xeadab0aba3b2dbe5ull, 0x2b45ac74ccea842eull,
+        0x92c8ae6b464fc96full, 0x3b0b8bc90012929dull,
+        0xb77ada0617e3bbcbull, 0x09ce6ebb40173744ull,
+        0xe55990879ddcaabdull, 0xcc420a6a101d0515ull,
+        0x8f57fa54c2a9eab6ull, 0x9fa946824a12232dull,
+        0xb32df8e9f3546564ull, 0x47939822dc96abf9ull,
+        0xdff9772470297ebdull, 0x59787e2b93bc56f7ull,
+        0x8bfbea76c619ef36ull, 0x57eb4edb3c55b65aull,
+        0xaefae51477a06b03ull, 0xede622920b6b23f1ull,
+        0xdab99e59958885c4ull, 0xe95fab368e45ecedull,
+        0x88b402f7fd75539bull, 0x11dbcb0218ebb414ull,
+        0xaae103b5fcd2a881ull, 0xd652bdc29f26a119ull,
+        0xd59944a37c0752a2ull, 0x4be76d3346f0495full,
+        0x857fcae62d8493a5ull, 0x6f70a4400c562ddbull,
+        0xa6dfbd9fb8e5b88eull, 0xcb4ccd500f6bb952ull,
+        0xd097ad07a71f26b2ull, 0x7e2000a41346a7a7ull,
+        0x825ecc24c873782full, 0x8ed400668c0c28c8ull,
+        0xa2f67f2dfa90563bull, 0x728900802f0f32faull,
+        0xcbb41ef979346bcaull, 0x4f2b40a03ad2ffb9ull,
+        0xfea126b7d78186bcull, 0xe2f610c84987bfa8ull,
+        0x9f24b832e6b0f436ull, 0x0dd9ca7d2df4d7c9ull,
+        0xc6ede63fa05d3143ull, 0x91503d1c79720dbbull,
+        0xf8a95fcf88747d94ull, 0x75a44c6397ce912aull,
+        0x9b69dbe1b548ce7cull, 0xc986afbe3ee11abaull,
+        0xc24452da229b021bull, 0xfbe85badce996168ull,
+        0xf2d56790ab41c2a2ull, 0xfae27299423fb9c3ull,
+        0x97c560ba6b0919a5ull, 0xdccd879fc967d41aull,
+        0xbdb6b8e905cb600full, 0x5400e987bbc1c920ull,
+        0xed246723473e3813ull, 0x290123e9aab23b68ull,
+        0x9436c0760c86e30bull, 0xf9a0b6720aaf6521ull,
+        0xb94470938fa89bceull, 0xf808e40e8d5b3e69ull,
+        0xe7958cb87392c2c2ull, 0xb60b1d1230b20e04ull,
+        0x90bd77f3483bb9b9ull, 0xb1c6f22b5e6f48c2ull,
+        0xb4ecd5f01a4aa828ull, 0x1e38aeb6360b1af3ull,
+        0xe2280b6c20dd5232ull, 0x25c6da63c38de1b0ull,
+        0x8d590723948a535full, 0x579c487e5a38ad0eull,
+        0xb0af48ec79ace837ull, 0x2d835a9df0c6d851ull,
+        0xdcdb1b2798182244ull, 0xf8e431456cf88e65ull,
+        0x8a08f0f8bf0f156bull, 0x1b8e9ecb641b58ffull,
+        0xac8b2d36eed2dac5ull, 0xe272467e3d222f3full,
+        0xd7adf884aa879177ull, 0x5b0ed81dcc6abb0full,
+        0x86ccbb52ea94baeaull, 0x98e947129fc2b4e9ull,
+        0xa87fea27a539e9a5ull, 0x3f2398d747b36224ull,
+        0xd29fe4b18e88640eull, 0x8eec7f0d19a03aadull,
+        0x83a3eeeef9153e89ull, 0x1953cf68300424acull,
+        0xa48ceaaab75a8e2bull, 0x5fa8c3423c052dd7ull,
+        0xcdb02555653131b6ull, 0x3792f412cb06794dull,
+        0x808e17555f3ebf11ull, 0xe2bbd88bbee40bd0ull,
+        0xa0b19d2ab70e6ed6ull, 0x5b6aceaeae9d0ec4ull,
+        0xc8de047564d20a8bull, 0xf245825a5a445275ull,
+        0xfb158592be068d2eull, 0xeed6e2f0f0d56712ull,
+        0x9ced737bb6c4183dull, 0x55464dd69685606bull,
+        0xc428d05aa4751e4cull, 0xaa97e14c3c26b886ull,
+        0xf53304714d9265dfull, 0xd53dd99f4b3066a8ull,
+        0x993fe2c6d07b7fabull, 0xe546a8038efe4029ull,
+        0xbf8fdb78849a5f96ull, 0xde98520472bdd033ull,
+        0xef73d256a5c0f77cull, 0x963e66858f6d4440ull,
+        0x95a8637627989aadull, 0xdde7001379a44aa8ull,
+        0xbb127c53b17ec159ull, 0x5560c018580d5d52ull,
+        0xe9d71b689dde71afull, 0xaab8f01e6e10b4a6ull,
+        0x9226712162ab070dull, 0xcab3961304ca70e8ull,
+        0xb6b00d69bb55c8d1ull, 0x3d607b97c5fd0d22ull,
+        0xe45c10c42a2b3b05ull, 0x8cb89a7db77c506aull,
+        0x8eb98a7a9a5b04e3ull, 0x77f3608e92adb242ull,
+        0xb267ed1940f1c61cull, 0x55f038b237591ed3ull,
+        0xdf01e85f912e37a3ull, 0x6b6c46dec52f6688ull,
+        0x8b61313bbabce2c6ull, 0x2323ac4b3b3da015ull,
+        0xae397d8aa96c1b77ull, 0xabec975e0a0d081aull,
+        0xd9c7dced53c72255ull, 0x96e7bd358c904a21ull,
+        0x881cea14545c7575ull, 0x7e50d64177da2e54ull,
+        0xaa242499697392d2ull, 0xdde50bd1d5d0b9e9ull,
+        0xd4ad2dbfc3d07787ull, 0x955e4ec64b44e864ull,
+        0x84ec3c97da624ab4ull, 0xbd5af13bef0b113eull,
+        0xa6274bbdd0fadd61ull, 0xecb1ad8aeacdd58eull,
+        0xcfb11ead453994baull, 0x67de18eda5814af2ull,
+        0x81ceb32c4b43fcf4ull, 0x80eacf948770ced7ull,
+        0xa2425ff75e14fc31ull, 0xa1258379a94d028dull,
+        0xcad2f7f5359a3b3eull, 0x096ee45813a04330ull,
+        0xfd87b5f28300ca0dull, 0x8bca9d6e188853fcull,
+        0x9e74d1b791e07e48ull, 0x775ea264cf55347eull,
+        0xc612062576589ddaull, 0x95364afe032a819eull,
+        0xf79687aed3eec551ull, 0x3a83ddbd83f52205ull,
+        0x9abe14cd44753b52ull, 0xc4926a9672793543ull,
+        0xc16d9a0095928a27ull, 0x75b7053c0f178294ull,
+        0xf1c90080baf72cb1ull, 0x5324c68b12dd6339ull,
+        0x971da05074da7beeull, 0xd3f6fc16ebca5e04ull,
+        0xbce5086492111aeaull, 0x88f4bb1ca6bcf585ull,
+        0xec1e4a7db69561a5ull, 0x2b31e9e3d06c32e6ull,
+        0x9392ee8e921d5d07ull, 0x3aff322e62439fd0ull,
+        0xb877aa3236a4b449ull, 0x09befeb9fad487c3ull,
+        0xe69594bec44de15bull, 0x4c2ebe687989a9b4ull,
+        0x901d7cf73ab0acd9ull, 0x0f9d37014bf60a11ull,
+        0xb424dc35095cd80full, 0x538484c19ef38c95ull,
+        0xe12e13424bb40e13ull, 0x2865a5f206b06fbaull,
+        0x8cbccc096f5088cbull, 0xf93f87b7442e45d4ull,
+        0xafebff0bcb24aafeull, 0xf78f69a51539d749ull,
+        0xdbe6fecebdedd5beull, 0xb573440e5a884d1cull,
+        0x89705f4136b4a597ull, 0x31680a88f8953031ull,
+        0xabcc77118461cefcull, 0xfdc20d2b36ba7c3eull,
+        0xd6bf94d5e57a42bcull, 0x3d32907604691b4dull,
+        0x8637bd05af6c69b5ull, 0xa63f9a49c2c1b110ull,
+        0xa7c5ac471b478423ull, 0x0fcf80dc33721d54ull,
+        0xd1b71758e219652bull, 0xd3c36113404ea4a9ull,
+        0x83126e978d4fdf3bull, 0x645a1cac083126eaull,
+        0xa3d70a3d70a3d70aull, 0x3d70a3d70a3d70a4ull,
+        0xccccccccccccccccull, 0xcccccccccccccccdull,
+        0x8000000000000000ull, 0x0000000000000000ull,
+        0xa000000000000000ull, 0x0000000000000000ull,
+        0xc800000000000000ull, 0x0000000000000000ull,
+        0xfa00000000000000ull, 0x0000000000000000ull,
+        0x9c40000000000000ull, 0x0000000000000000ull,
+        0xc350000000000000ull, 0x0000000000000000ull,
+        0xf424000000000000ull, 0x0000000000000000ull,
+        0x9896800000000000ull, 0x0000000000000000ull,
+        0xbebc200000000000ull, 0x0000000000000000ull,
+        0xee6b280000000000ull, 0x0000000000000000ull,
+        0x9502f90000000000ull, 0x0000000000000000ull,
+        0xba43b74000000000ull, 0x0000000000000000ull,
+        0xe8d4a51000000000ull, 0x0000000000000000ull,
+        0x9184e72a00000000ull, 0x0000000000000000ull,
+        0xb5e620f480000000ull, 0x0000000000000000ull,
+        0xe35fa931a0000000ull, 0x0000000000000000ull,
+        0x8e1bc9bf04000000ull, 0x0000000000000000ull,
+        0xb1a2bc2ec5000000ull, 0x0000000000000000ull,
+        0xde0b6b3a76400000ull, 0x0000000000000000ull,
+        0x8ac7230489e80000ull, 0x0000000000000000ull,
+        0xad78ebc5ac620000ull, 0x0000000000000000ull,
+        0xd8d726b7177a8000ull, 0x0000000000000000ull,
+        0x878678326eac9000ull, 0x0000000000000000ull,
+        0xa968163f0a57b400ull, 0x0000000000000000ull,
+        0xd3c21bcecceda100ull, 0x0000000000000000ull,
+        0x84595161401484a0ull, 0x0000000000000000ull,
+        0xa56fa5b99019a5c8ull, 0x0000000000000000ull,
+        0xcecb8f27f4200f3aull, 0x0000000000000000ull,
+        0x813f3978f8940984ull, 0x4000000000000000ull,
+        0xa18f07d736b90be5ull, 0x5000000000000000ull,
+        0xc9f2c9cd04674edeull, 0xa400000000000000ull,
+        0xfc6f7c4045812296ull, 0x4d00000000000000ull,
+        0x9dc5ada82b70b59dull, 0xf020000000000000ull,
+        0xc5371912364ce305ull, 0x6c28000000000000ull,
+        0xf684df56c3e01bc6ull, 0xc732000000000000ull,
+        0x9a130b963a6c115cull, 0x3c7f400000000000ull,
+        0xc097ce7bc90715b3ull, 0x4b9f100000000000ull,
+        0xf0bdc21abb48db20ull, 0x1e86d40000000000ull,
+        0x96769950b50d88f4ull, 0x1314448000000000ull,
+        0xbc143fa4e250eb31ull, 0x17d955a000000000ull,
+        0xeb194f8e1ae525fdull, 0x5dcfab0800000000ull,
+        0x92efd1b8d0cf37beull, 0x5aa1cae500000000ull,
+        0xb7abc627050305adull, 0xf14a3d9e40000000ull,
+        0xe596b7b0c643c719ull, 0x6d9ccd05d0000000ull,
+        0x8f7e32ce7bea5c6full, 0xe4820023a2000000ull,
+        0xb35dbf821ae4f38bull, 0xdda2802c8a800000ull,
+        0xe0352f62a19e306eull, 0xd50b2037ad200000ull,
+        0x8c213d9da502de45ull, 0x4526f422cc340000ull,
+        0xaf298d050e4395d6ull, 0x9670b12b7f410000ull,
+        0xdaf3f04651d47b4cull, 0x3c0cdd765f114000ull,
+        0x88d8762bf324cd0full, 0xa5880a69fb6ac800ull,
+        0xab0e93b6efee0053ull, 0x8eea0d047a457a00ull,
+        0xd5d238a4abe98068ull, 0x72a4904598d6d880ull,
+        0x85a36366eb71f041ull, 0x47a6da2b7f864750ull,
+        0xa70c3c40a64e6c51ull, 0x999090b65f67d924ull,
+        0xd0cf4b50cfe20765ull, 0xfff4b4e3f741cf6dull,
+        0x82818f1281ed449full, 0xbff8f10e7a8921a4ull,
+        0xa321f2d7226895c7ull, 0xaff72d52192b6a0dull,
+        0xcbea6f8ceb02bb39ull, 0x9bf4f8a69f764490ull,
+        0xfee50b7025c36a08ull, 0x02f236d04753d5b4ull,
+        0x9f4f2726179a2245ull, 0x01d762422c946590ull,
+        0xc722f0ef9d80aad6ull, 0x424d3ad2b7b97ef5ull,
+        0xf8ebad2b84e0d58bull, 0xd2e0898765a7deb2ull,
+        0x9b934c3b330c8577ull, 0x63cc55f49f88eb2full,
+        0xc2781f49ffcfa6d5ull, 0x3cbf6b71c76b25fbull,
+        0xf316271c7fc3908aull, 0x8bef464e3945ef7aull,
+        0x97edd871cfda3a56ull, 0x97758bf0e3cbb5acull,
+        0xbde94e8e43d0c8ecull, 0x3d52eeed1cbea317ull,
+        0xed63a231d4c4fb27ull, 0x4ca7aaa863ee4bddull,
+        0x945e455f24fb1cf8ull, 0x8fe8caa93e74ef6aull,
+        0xb975d6b6ee39e436ull, 0xb3e2fd538e122b44ull,
+        0xe7d34c64a9c85d44ull, 0x60dbbca87196b616ull,
+        0x90e40fbeea1d3a4aull, 0xbc8955e946fe31cdull,
+        0xb51d13aea4a488ddull, 0x6babab6398bdbe41ull,
+        0xe264589a4dcdab14ull, 0xc696963c7eed2dd1ull,
+        0x8d7eb76070a08aecull, 0xfc1e1de5cf543ca2ull,
+        0xb0de65388cc8ada8ull, 0x3b25a55f43294bcbull,
+        0xdd15fe86affad912ull, 0x49ef0eb713f39ebeull,
+        0x8a2dbf142dfcc7abull, 0x6e3569326c784337ull,
+        0xacb92ed9397bf996ull, 0x49c2c37f07965404ull,
+        0xd7e77a8f87daf7fbull, 0xdc33745ec97be906ull,
+        0x86f0ac99b4e8dafdull, 0x69a028bb3ded71a3ull,
+        0xa8acd7c0222311bcull, 0xc40832ea0d68ce0cull,
+        0xd2d80db02aabd62bull, 0xf50a3fa490c30190ull,
+        0x83c7088e1aab65dbull, 0x792667c6da79e0faull,
+        0xa4b8cab1a1563f52ull, 0x577001b891185938ull,
+        0xcde6fd5e09abcf26ull, 0xed4c0226b55e6f86ull,
+        0x80b05e5ac60b6178ull, 0x544f8158315b05b4ull,
+        0xa0dc75f1778e39d6ull, 0x696361ae3db1c721ull,
+        0xc913936dd571c84cull, 0x03bc3a19cd1e38e9ull,
+        0xfb5878494ace3a5full, 0x04ab48a04065c723ull,
+        0x9d174b2dcec0e47bull, 0x62eb0d64283f9c76ull,
+        0xc45d1df942711d9aull, 0x3ba5d0bd324f8394ull,
+        0xf5746577930d6500ull, 0xca8f44ec7ee36479ull,
+        0x9968bf6abbe85f20ull, 0x7e998b13cf4e1ecbull,
+        0xbfc2ef456ae276e8ull, 0x9e3fedd8c321a67eull,
+        0xefb3ab16c59b14a2ull, 0xc5cfe94ef3ea101eull,
+        0x95d04aee3b80ece5ull, 0xbba1f1d158724a12ull,
+        0xbb445da9ca61281full, 0x2a8a6e45ae8edc97ull,
+        0xea1575143cf97226ull, 0xf52d09d71a3293bdull,
+        0x924d692ca61be758ull, 0x593c2626705f9c56ull,
+        0xb6e0c377cfa2e12eull, 0x6f8b2fb00c77836cull,
+        0xe498f455c38b997aull, 0x0b6dfb9c0f956447ull,
+        0x8edf98b59a373fecull, 0x4724bd4189bd5eacull,
+        0xb2977ee300c50fe7ull, 0x58edec91ec2cb657ull,
+        0xdf3d5e9bc0f653e1ull, 0x2f2967b66737e3edull,
+        0x8b865b215899f46cull, 0xbd79e0d20082ee74ull,
+        0xae67f1e9aec07187ull, 0xecd8590680a3aa11ull,
+        0xda01ee641a708de9ull, 0xe80e6f4820cc9495ull,
+        0x884134fe908658b2ull, 0x3109058d147fdcddull,
+        0xaa51823e34a7eedeull, 0xbd4b46f0599fd415ull,
+        0xd4e5e2cdc1d1ea96ull, 0x6c9e18ac7007c91aull,
+        0x850fadc09923329eull, 0x03e2cf6bc604ddb0ull,
+        0xa6539930bf6bff45ull, 0x84db8346b786151cull,
+        0xcfe87f7cef46ff16ull, 0xe612641865679a63ull,
+        0x81f14fae158c5f6eull, 0x4fcb7e8f3f60c07eull,
+        0xa26da3999aef7749ull, 0xe3be5e330f38f09dull,
+        0xcb090c8001ab551cull, 0x5cadf5bfd3072cc5ull,
+        0xfdcb4fa002162a63ull, 0x73d9732fc7c8f7f6ull,
+        0x9e9f11c4014dda7eull, 0x2867e7fddcdd9afaull,
+        0xc646d63501a1511dull, 0xb281e1fd541501b8ull,
+        0xf7d88bc24209a565ull, 0x1f225a7ca91a4226ull,
+        0x9ae757596946075full, 0x3375788de9b06958ull,
+        0xc1a12d2fc3978937ull, 0x0052d6b1641c83aeull,
+        0xf209787bb47d6b84ull, 0xc0678c5dbd23a49aull,
+        0x9745eb4d50ce6332ull, 0xf840b7ba963646e0ull,
+        0xbd176620a501fbffull, 0xb650e5a93bc3d898ull,
+        0xec5d3fa8ce427affull, 0xa3e51f138ab4cebeull,
+        0x93ba47c980e98cdfull, 0xc66f336c36b10137ull,
+        0xb8a8d9bbe123f017ull, 0xb80b0047445d4184ull,
+        0xe6d3102ad96cec1dull, 0xa60dc059157491e5ull,
+        0x9043ea1ac7e41392ull, 0x87c89837ad68db2full,
+        0xb454e4a179dd1877ull, 0x29babe4598c311fbull,
+        0xe16a1dc9d8545e94ull, 0xf4296dd6fef3d67aull,
+        0x8ce2529e2734bb1dull, 0x1899e4a65f58660cull,
+        0xb01ae745b101e9e4ull, 0x5ec05dcff72e7f8full,
+        0xdc21a1171d42645dull, 0x76707543f4fa1f73ull,
+        0x899504ae72497ebaull, 0x6a06494a791c53a8ull,
+        0xabfa45da0edbde69ull, 0x0487db9d17636892ull,
+        0xd6f8d7509292d603ull, 0x45a9d2845d3c42b6ull,
+        0x865b86925b9bc5c2ull, 0x0b8a2392ba45a9b2ull,
+        0xa7f26836f282b732ull, 0x8e6cac7768d7141eull,
+        0xd1ef0244af2364ffull, 0x3207d795430cd926ull,
+        0x8335616aed761f1full, 0x7f44e6bd49e807b8ull,
+        0xa402b9c5a8d3a6e7ull, 0x5f16206c9c6209a6ull,
+        0xcd036837130890a1ull, 0x36dba887c37a8c0full,
+        0x802221226be55a64ull, 0xc2494954da2c9789ull,
+        0xa02aa96b06deb0fdull, 0xf2db9baa10b7bd6cull,
+        0xc83553c5c8965d3dull, 0x6f92829494e5acc7ull,
+        0xfa42a8b73abbf48cull, 0xcb772339ba1f17f9ull,
+        0x9c69a97284b578d7ull, 0xff2a760414536efbull,
+        0xc38413cf25e2d70dull, 0xfef5138519684abaull,
+        0xf46518c2ef5b8cd1ull, 0x7eb258665fc25d69ull,
+        0x98bf2f79d5993802ull, 0xef2f773ffbd97a61ull,
+        0xbeeefb584aff8603ull, 0xaafb550ffacfd8faull,
+        0xeeaaba2e5dbf6784ull, 0x95ba2a53f983cf38ull,
+        0x952ab45cfa97a0b2ull, 0xdd945a747bf26183ull,
+        0xba756174393d88dfull, 0x94f971119aeef9e4ull,
+        0xe912b9d1478ceb17ull, 0x7a37cd5601aab85dull,
+        0x91abb422ccb812eeull, 0xac62e055c10ab33aull,
+        0xb616a12b7fe617aaull, 0x577b986b314d6009ull,
+        0xe39c49765fdf9d94ull, 0xed5a7e85fda0b80bull,
+        0x8e41ade9fbebc27dull, 0x14588f13be847307ull,
+        0xb1d219647ae6b31cull, 0x596eb2d8ae258fc8ull,
+        0xde469fbd99a05fe3ull, 0x6fca5f8ed9aef3bbull,
+        0x8aec23d680043beeull, 0x25de7bb9480d5854ull,
+        0xada72ccc20054ae9ull, 0xaf561aa79a10ae6aull,
+        0xd910f7ff28069da4ull, 0x1b2ba1518094da04ull,
+        0x87aa9aff79042286ull, 0x90fb44d2f05d0842ull,
+        0xa99541bf57452b28ull, 0x353a1607ac744a53ull,
+        0xd3fa922f2d1675f2ull, 0x42889b8997915ce8ull,
+        0x847c9b5d7c2e09b7ull, 0x69956135febada11ull,
+        0xa59bc234db398c25ull, 0x43fab9837e699095ull,
+        0xcf02b2c21207ef2eull, 0x94f967e45e03f4bbull,
+        0x8161afb94b44f57dull, 0x1d1be0eebac278f5ull,
+        0xa1ba1ba79e1632dcull, 0x6462d92a69731732ull,
+        0xca28a291859bbf93ull, 0x7d7b8f7503cfdcfeull,
+        0xfcb2cb35e702af78ull, 0x5cda735244c3d43eull,
+        0x9defbf01b061adabull, 0x3a0888136afa64a7ull,
+        0xc56baec21c7a1916ull, 0x088aaa1845b8fdd0ull,
+        0xf6c69a72a3989f5bull, 0x8aad549e57273d45ull,
+        0x9a3c2087a63f6399ull, 0x36ac54e2f678864bull,
+        0xc0cb28a98fcf3c7full, 0x84576a1bb416a7ddull,
+        0xf0fdf2d3f3c30b9full, 0x656d44a2a11c51d5ull,
+        0x969eb7c47859e743ull, 0x9f644ae5a4b1b325ull,
+        0xbc4665b596706114ull, 0x873d5d9f0dde1feeull,
+        0xeb57ff22fc0c7959ull, 0xa90cb506d155a7eaull,
+        0x9316ff75dd87cbd8ull, 0x09a7f12442d588f2ull,
+        0xb7dcbf5354e9beceull, 0x0c11ed6d538aeb2full,
+        0xe5d3ef282a242e81ull, 0x8f1668c8a86da5faull,
+        0x8fa475791a569d10ull, 0xf96e017d694487bcull,
+        0xb38d92d760ec4455ull, 0x37c981dcc395a9acull,
+        0xe070f78d3927556aull, 0x85bbe253f47b1417ull,
+        0x8c469ab843b89562ull, 0x93956d7478ccec8eull,
+        0xaf58416654a6babbull, 0x387ac8d1970027b2ull,
+        0xdb2e51bfe9d0696aull, 0x06997b05fcc0319eull,
+        0x88fcf317f22241e2ull, 0x441fece3bdf81f03ull,
+        0xab3c2fddeeaad25aull, 0xd527e81cad7626c3ull,
+        0xd60b3bd56a5586f1ull, 0x8a71e223d8d3b074ull,
+        0x85c7056562757456ull, 0xf6872d5667844e49ull,
+        0xa738c6bebb12d16cull, 0xb428f8ac016561dbull,
+        0xd106f86e69d785c7ull, 0xe13336d701beba52ull,
+        0x82a45b450226b39cull, 0xecc0024661173473ull,
+        0xa34d721642b06084ull, 0x27f002d7f95d0190ull,
+        0xcc20ce9bd35c78a5ull, 0x31ec038df7b441f4ull,
+        0xff290242c83396ceull, 0x7e67047175a15271ull,
+        0x9f79a169bd203e41ull, 0x0f0062c6e984d386ull,
+        0xc75809c42c684dd1ull, 0x52c07b78a3e60868ull,
+        0xf92e0c3537826145ull, 0xa7709a56ccdf8a82ull,
+        0x9bbcc7a142b17ccbull, 0x88a66076400bb691ull,
+        0xc2abf989935ddbfeull, 0x6acff893d00ea435ull,
+        0xf356f7ebf83552feull, 0x0583f6b8c4124d43ull,
+        0x98165af37b2153deull, 0xc3727a337a8b704aull,
+        0xbe1bf1b059e9a8d6ull, 0x744f18c0592e4c5cull,
+        0xeda2ee1c7064130cull, 0x1162def06f79df73ull,
+        0x9485d4d1c63e8be7ull, 0x8addcb5645ac2ba8ull,
+        0xb9a74a0637ce2ee1ull, 0x6d953e2bd7173692ull,
+        0xe8111c87c5c1ba99ull, 0xc8fa8db6ccdd0437ull,
+        0x910ab1d4db9914a0ull, 0x1d9c9892400a22a2ull,
+        0xb54d5e4a127f59c8ull, 0x2503beb6d00cab4bull,
+        0xe2a0b5dc971f303aull, 0x2e44ae64840fd61dull,
+        0x8da471a9de737e24ull, 0x5ceaecfed289e5d2ull,
+        0xb10d8e1456105dadull, 0x7425a83e872c5f47ull,
+        0xdd50f1996b947518ull, 0xd12f124e28f77719ull,
+        0x8a5296ffe33cc92full, 0x82bd6b70d99aaa6full,
+        0xace73cbfdc0bfb7bull, 0x636cc64d1001550bull,
+        0xd8210befd30efa5aull, 0x3c47f7e05401aa4eull,
+        0x8714a775e3e95c78ull, 0x65acfaec34810a71ull,
+        0xa8d9d1535ce3b396ull, 0x7f1839a741a14d0dull,
+        0xd31045a8341ca07cull, 0x1ede48111209a050ull,
+        0x83ea2b892091e44dull, 0x934aed0aab460432ull,
+        0xa4e4b66b68b65d60ull, 0xf81da84d5617853full,
+        0xce1de40642e3f4b9ull, 0x36251260ab9d668eull,
+        0x80d2ae83e9ce78f3ull, 0xc1d72b7c6b426019ull,
+        0xa1075a24e4421730ull, 0xb24cf65b8612f81full,
+        0xc94930ae1d529cfcull, 0xdee033f26797b627ull,
+        0xfb9b7cd9a4a7443cull, 0x169840ef017da3b1ull,
+        0x9d412e0806e88aa5ull, 0x8e1f289560ee864eull,
+        0xc491798a08a2ad4eull, 0xf1a6f2bab92a27e2ull,
+        0xf5b5d7ec8acb58a2ull, 0xae10af696774b1dbull,
+        0x9991a6f3d6bf1765ull, 0xacca6da1e0a8ef29ull,
+        0xbff610b0cc6edd3full, 0x17fd090a58d32af3ull,
+        0xeff394dcff8a948eull, 0xddfc4b4cef07f5b0ull,
+        0x95f83d0a1fb69cd9ull, 0x4abdaf101564f98eull,
+        0xbb764c4ca7a4440full, 0x9d6d1ad41abe37f1ull,
+        0xea53df5fd18d5513ull, 0x84c86189216dc5edull,
+        0x92746b9be2f8552cull, 0x32fd3cf5b4e49bb4ull,
+        0xb7118682dbb66a77ull, 0x3fbc8c33221dc2a1ull,
+        0xe4d5e82392a40515ull, 0x0fabaf3feaa5334aull,
+        0x8f05b1163ba6832dull, 0x29cb4d87f2a7400eull,
+        0xb2c71d5bca9023f8ull, 0x743e20e9ef511012ull,
+        0xdf78e4b2bd342cf6ull, 0x914da9246b255416ull,
+        0x8bab8eefb6409c1aull, 0x1ad089b6c2f7548eull,
+        0xae9672aba3d0c320ull, 0xa184ac2473b529b1ull,
+        0xda3c0f568cc4f3e8ull, 0xc9e5d72d90a2741eull,
+        0x8865899617fb1871ull, 0x7e2fa67c7a658892ull,
+        0xaa7eebfb9df9de8dull, 0xddbb901b98feeab7ull,
+        0xd51ea6fa85785631ull, 0x552a74227f3ea565ull,
+        0x8533285c936b35deull, 0xd53a88958f87275full,
+        0xa67ff273b8460356ull, 0x8a892abaf368f137ull,
+        0xd01fef10a657842cull, 0x2d2b7569b0432d85ull,
+        0x8213f56a67f6b29bull, 0x9c3b29620e29fc73ull,
+        0xa298f2c501f45f42ull, 0x8349f3ba91b47b8full,
+        0xcb3f2f7642717713ull, 0x241c70a936219a73ull,
+        0xfe0efb53d30dd4d7ull, 0xed238cd383aa0110ull,
+        0x9ec95d1463e8a506ull, 0xf4363804324a40aaull,
+        0xc67bb4597ce2ce48ull, 0xb143c6053edcd0d5ull,
+        0xf81aa16fdc1b81daull, 0xdd94b7868e94050aull,
+        0x9b10a4e5e9913128ull, 0xca7cf2b4191c8326ull,
+        0xc1d4ce1f63f57d72ull, 0xfd1c2f611f63a3f0ull,
+        0xf24a01a73cf2dccfull, 0xbc633b39673c8cecull,
+        0x976e41088617ca01ull, 0xd5be0503e085d813ull,
+        0xbd49d14aa79dbc82ull, 0x4b2d8644d8a74e18ull,
+        0xec9c459d51852ba2ull, 0xddf8e7d60ed1219eull,
+        0x93e1ab8252f33b45ull, 0xcabb90e5c942b503ull,
+        0xb8da1662e7b00a17ull, 0x3d6a751f3b936243ull,
+        0xe7109bfba19c0c9dull, 0x0cc512670a783ad4ull,
+        0x906a617d450187e2ull, 0x27fb2b80668b24c5ull,
+        0xb484f9dc9641e9daull, 0xb1f9f660802dedf6ull,
+        0xe1a63853bbd26451ull, 0x5e7873f8a0396973ull,
+        0x8d07e33455637eb2ull, 0xdb0b487b6423e1e8ull,
+        0xb049dc016abc5e5full, 0x91ce1a9a3d2cda62ull,
+        0xdc5c5301c56b75f7ull, 0x7641a140cc7810fbull,
+        0x89b9b3e11b6329baull, 0xa9e904c87fcb0a9dull,
+        0xac2820d9623bf429ull, 0x546345fa9fbdcd44ull,
+        0xd732290fbacaf133ull, 0xa97c177947ad4095ull,
+        0x867f59a9d4bed6c0ull, 0x49ed8eabcccc485dull,
+        0xa81f301449ee8c70ull, 0x5c68f256bfff5a74ull,
+        0xd226fc195c6a2f8cull, 0x73832eec6fff3111ull,
+        0x83585d8fd9c25db7ull, 0xc831fd53c5ff7eabull,
+        0xa42e74f3d032f525ull, 0xba3e7ca8b77f5e55ull,
+        0xcd3a1230c43fb26full, 0x28ce1bd2e55f35ebull,
+        0x80444b5e7aa7cf85ull, 0x7980d163cf5b81b3ull,
+        0xa0555e361951c366ull, 0xd7e105bcc332621full,
+        0xc86ab5c39fa63440ull, 0x8dd9472bf3fefaa7ull,
+        0xfa856334878fc150ull, 0xb14f98f6f0feb951ull,
+        0x9c935e00d4b9d8d2ull, 0x6ed1bf9a569f33d3ull,
+        0xc3b8358109e84f07ull, 0x0a862f80ec4700c8ull,
+        0xf4a642e14c6262c8ull, 0xcd27bb612758c0faull,
+        0x98e7e9cccfbd7dbdull, 0x8038d51cb897789cull,
+        0xbf21e44003acdd2cull, 0xe0470a63e6bd56c3ull,
+        0xeeea5d5004981478ull, 0x1858ccfce06cac74ull,
+        0x95527a5202df0ccbull, 0x0f37801e0c43ebc8ull,
+        0xbaa718e68396cffdull, 0xd30560258f54e6baull,
+        0xe950df20247c83fdull, 0x47c6b82ef32a2069ull,
+        0x91d28b7416cdd27eull, 0x4cdc331d57fa5441ull,
+        0xb6472e511c81471dull, 0xe0133fe4adf8e952ull,
+        0xe3d8f9e563a198e5ull, 0x58180fddd97723a6ull,
+        0x8e679c2f5e44ff8full, 0x570f09eaa7ea7648ull,
+};
 
 /*
  * A header only library to parse command line arguments
@@ -42,17 +1303,31 @@
  *      std::string -> no need to check the status of optional because conversion status will always be true
  *      bool -> if source string is (case sensitive) "true"/"false", then conversion succeeds to corresponding values
  *              otherwise conversion fails and returned value is std::nullopt
+ *      std::vector<T> -> the value is split at each ',' (see @setListDelimiter) and each element is converted to T
+ *              a trailing ',' is ignored
+ *              conversion fails if conversion of any element fails
  *
  * Help message:
  *      If application is run with -h or --help flag, then @needHelp returns true and user should call @helpMsg
  *      and must return because, in this case when parse() was called, no actual parsing was done
  *      Otherwise, any attempt to retrieve any value will throw exception
  *
+ * Shell completion:
+ *      @completionScript generates a bash/zsh/fish script with all the configured arguments
+ *      If application is run with `--complete <prefix>`, then @needCompletion returns true and user should
+ *      print @completionMsg and return, same as for help
+ *
  * Additional details:
  *      - Functions which are not noexcept might throw exception
  *      - arguments must only consist of alphanumeric characters and underscores
  *      - short option must be shorter in size than the long option
  * */
+class ArgSnapshot;
+class ArgOverlay;
+class LiveArgs;
+template<typename T>
+class ArgFlag;
+
 class ArgParser
 {
 public:
@@ -77,620 +1352,5048 @@ public:
     ArgParser &addArgumentWithDefault(const std::string &shortOpt, const std::string &longOpt,
                                       const std::string &helpMsg, const T &defaultValue);
 
-    // To parse the command line arguments
-    // Should be called with the arguments of main function
-    // It will throw exception if:
-    //  - Any of the mandatory configured argument are not passed
-    //  - Configured arguments are repeated
-    void parse(int argc, char *argv[]);
+    // An argument for @addArguments, it is mandatory or has a default value, not both
+    struct ArgSpec
+    {
+        std::string shortOpt{};
+        std::string longOpt{};
+        std::string helpMsg{};
+        std::optional<std::string> defaultValue{};
+        bool isMandatory{false};
+    };
 
-    // As the first command line argument is always application path, it returns the same
-    const std::string &getAppPath() const noexcept;
+    // To add many arguments at once e.g. registered by plugins, it is cheaper than adding them one by one:
+    //   argParser.addArguments({{"-w", "--waitTime", "Wait time", "10"}, {"-l", "--logfile", "Log file", {}, true}});
+    // All of them are validated before any is added, so either all of them are added or none
+    // It will throw exception naming every invalid or duplicate argument, duplicates are found among @args and
+    // with already configured arguments
+    ArgParser &addArguments(const std::vector<ArgSpec> &args);
+
+    // A handle of a configured argument, to retrieve its value as T without looking up its name
+    // It is valid for the ArgParser which returned it, and its copies e.g. in @LiveArgs
+    template<typename T>
+    class Opt
+    {
+    public:
+        [[nodiscard]] std::size_t slot() const noexcept;
+
+    private:
+        friend class ArgParser;
+
+        explicit Opt(std::size_t slot) noexcept;
+
+        std::size_t index;
+    };
+
+    // Same as @addArgument and @addArgumentWithDefault, but these return a handle of the argument e.g.
+    //   const auto waitTime = argParser.addTypedArgumentWithDefault("-w", "--waitTime", "Wait time", 10);
+    //   ...
+    //   const auto value = argParser.retrieve(waitTime); // std::optional<int>, no lookup by name
+    template<typename T = std::string>
+    Opt<T> addTypedArgument(const std::string &shortOpt, const std::string &longOpt, const std::string &helpMsg,
+                            bool isMandatory = false);
+
+    template<typename T>
+    Opt<T> addTypedArgumentWithDefault(const std::string &shortOpt, const std::string &longOpt,
+                                       const std::string &helpMsg, const T &defaultValue);
+
+    // Returns a handle of @arg which is already configured, e.g. a choice argument
+    // It will throw exception if @arg is not configured
+    template<typename T = std::string>
+    Opt<T> optOf(const std::string &arg) const;
+
+    // Same as @addArgument and @addArgumentWithDefault, but the argument is bound to @member of @config, so that
+    // parse() converts its value and writes it straight into the member e.g.
+    //   struct Config { std::string logFile; int waitTime{}; } config;
+    //   argParser.addBoundArgument("-l", "--logfile", "Log file", config, &Config::logFile, true)
+    //            .addBoundArgumentWithDefault("-w", "--waitTime", "Wait time", config, &Config::waitTime, 10);
+    //   argParser.parse(argc, argv); // config has all the values now, nothing has to be retrieved
+    // A member is written if its argument has a value, passed or from overrides or default values, otherwise it
+    // keeps its value
+    // parse() throws if a value can't be converted to its member, no member is written in that case, as all the
+    // values are converted before writing any of them
+    // @config must outlive parse() calls of this ArgParser and of its copies, LiveArgs doesn't write into it
+    template<typename Config, typename T>
+    ArgParser &addBoundArgument(const std::string &shortOpt, const std::string &longOpt, const std::string &helpMsg,
+                                Config &config, T Config::*member, bool isMandatory = false);
+
+    template<typename Config, typename T>
+    ArgParser &addBoundArgumentWithDefault(const std::string &shortOpt, const std::string &longOpt,
+                                           const std::string &helpMsg, Config &config, T Config::*member,
+                                           const std::common_type_t<T> &defaultValue);
+
+    // Quantities with units, which can be retrieved and be default values, same as std::chrono::duration e.g.:
+    //   argParser.addArgumentWithDefault("-b", "--buffer", "buffer size", ArgParser::ByteSize{64 << 20}); // 64MiB
+    //   argParser.addArgumentWithDefault("-t", "--timeout", "timeout", std::chrono::milliseconds{250}); // 250ms
+    //   const auto buffer = argParser.retrieve<ArgParser::ByteSize>("buffer"); // e.g. --buffer=1.5GiB
+    //   const auto timeout = argParser.retrieve<std::chrono::seconds>("timeout"); // e.g. --timeout=2min
+    // A number without a unit is in bytes, in the period of the duration, in ones, or per second
+    // Conversion fails if the value doesn't fit in the type, or isn't a whole number e.g. 1500us as milliseconds
+    // Units of bytes: B, KiB, MiB, GiB, TiB, PiB, EiB and kB, MB, GB, TB, PB, EB
+    // Units of durations: ns, us, ms, s, min, h, d
+    struct ByteSize
+    {
+        std::uint64_t bytes{0};
+
+        bool operator==(const ByteSize &other) const noexcept;
+    };
+
+    // Units: k, M, G, T, P, E, which are powers of 1000 e.g. --connections=10k
+    struct Count
+    {
+        std::uint64_t value{0};
+
+        bool operator==(const Count &other) const noexcept;
+    };
+
+    // Count, then '/' and a unit of durations e.g. --rate=10k/s or --rate=2.5/ms
+    struct Rate
+    {
+        double perSecond{0};
+
+        bool operator==(const Rate &other) const noexcept;
+    };
+
+    // To add an argument which accepts only one of @choices, these are retrieved as the mapped enum or integer e.g.:
+    //   argParser.addChoiceArgument("-m", "--mode", "run mode", {{"fast", Mode::Fast}, {"safe", Mode::Safe}});
+    //   const auto mode = argParser.retrieve<Mode>("mode"); // retrieve<std::string> still returns the passed value
+    // Any other value is rejected by parse(), with the list of allowed ones
+    // It will throw exception if @choices is empty, has duplicates or a mapped value above INT64_MAX, or for the
+    // same reasons as @addArgument
+    template<typename T>
+    ArgParser &addChoiceArgument(const std::string &shortOpt, const std::string &longOpt, const std::string &helpMsg,
+                                 const std::vector<std::pair<std::string, T>> &choices, bool isMandatory = false);
+
+    // Same as above, with @defaultChoice as default value, which must be one of @choices
+    template<typename T>
+    ArgParser &addChoiceArgumentWithDefault(const std::string &shortOpt, const std::string &longOpt,
+                                            const std::string &helpMsg,
+                                            const std::vector<std::pair<std::string, T>> &choices,
+                                            const std::string &defaultChoice);
+
+    // Constraints over configured arguments, which are checked together at the end of parse()
+    // Arguments are referred to as in @retrieve e.g. "l" or "logfile" and must already be configured
+    // Only passed arguments count, default values don't
+    // These will throw exception if any of the arguments is not configured
+    //  - @addMutuallyExclusive: at most one of @args can be passed
+    //  - @addAtLeastOne: at least one of @args must be passed
+    //  - @addRequires: if @arg is passed, then @required must be passed as well
+    ArgParser &addMutuallyExclusive(const std::vector<std::string> &args);
+
+    ArgParser &addAtLeastOne(const std::vector<std::string> &args);
+
+    ArgParser &addRequires(const std::string &arg, const std::string &required);
+
+    // Value of @arg when it is not passed in command line arguments, it takes precedence over the default value
+    // e.g. a value from a config file or environment, which doesn't change the schema or help message
+    // So a retrieved value comes from command line arguments, then overrides, then default values
+    // These are resolved when retrieved, so these can be set before or after parse()
+    // Overrides don't count as passed for mandatory arguments and constraints, same as default values
+    // It will throw exception if @arg is not configured, or @value is not one of its choices, or after parse(),
+    // if interpolation is enabled and @value references unknown arguments or a cycle, see @enableInterpolation
+    template<typename T>
+    ArgParser &setOverride(const std::string &arg, const T &value);
+
+    // Removes all the values set by @setOverride
+    // It will throw exception if interpolation is enabled and the values without overrides reference unknown
+    // arguments or a cycle, the overrides are kept in that case
+    ArgParser &clearOverrides();
+
+    // Delimiter of elements when a value is retrieved as std::vector<T>, ',' by default e.g.
+    //   const auto ids = argParser.retrieve<std::vector<int>>("ids"); // for --ids=1,2,3
+    // A trailing delimiter is ignored for every T, so "1,2," is the same as "1,2", while any other empty element
+    // is converted as an empty string, e.g. "a,,b" has an empty std::string, but isn't a list of numbers
+    ArgParser &setListDelimiter(char delimiter) noexcept;
+
+    // Expands ${name} in values with the value of argument name, ${env:NAME} with the environment variable NAME,
+    // and "$$" to '$' e.g. --out=${workdir}/results or --cache=${env:HOME}/.cache
+    // parse() checks that referenced arguments are configured and don't reference each other in a cycle, and
+    // throws otherwise, but a value is expanded only when it is retrieved first, and is kept till the next parse()
+    // An argument or environment variable without a value expands to nothing, and choices are not expanded
+    // It must be called before parse()
+    ArgParser &enableInterpolation() noexcept;
+
+    // Arguments which don't change what the application produces e.g. --verbose or --threads, these are left out
+    // of @fingerprint and @canonicalConfig
+    // It will throw exception if any of @args is not configured
+    ArgParser &excludeFromFingerprint(const std::vector<std::string> &args);
+
+    // To parse the command line arguments
+    // Should be called with the arguments of main function
+    // It will throw exception if:
+    //  - Any of the mandatory configured argument are not passed
+    //  - Any of the constraints is not satisfied
+    //  - Configured arguments are repeated
+    //  - A value can't be converted to the member it is bound to by @addBoundArgument
+    void parse(int argc, char *argv[]);
+
+    // Same as above, but nothing is stored, @visitor is called as visitor(std::size_t slot, std::string_view value):
+    //  - for every passed argument as soon as it is matched, @value is a view into @argv
+    //  - then for every argument which was not passed but has an override or a default value
+    // Mandatory arguments are checked at the end and there is no retrieval after this, use @slotOf to map slots
+    // If application was called with -h or --help, @visitor is never called and @needHelp returns true
+    template<typename Visitor>
+    void parse(int argc, char *argv[], Visitor &&visitor);
+
+    // Returned by @slotOf for unknown arguments and passed as slot to stream handlers for positional items
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    // To parse items streamed from @input (e.g. std::cin in `find -print0 | app`), as xargs does
+    // Items are separated by @delimiter, pass '\0' for NUL separated input, empty items are skipped
+    // @handler is called as handler(std::size_t slot, std::string_view value) for each item as soon as it is read:
+    //  - an item starting with '-' must be a configured key=value pair, slot is the one returned by @slotOf
+    //  - any other item is positional, slot is @npos and value is the whole item
+    // Nothing is collected into parsed arguments, the input is read through a fixed size buffer and
+    // @value is only valid during the call, so memory doesn't grow with the number of items
+    // Options may be repeated and mandatory arguments are not checked, unlike parse(argc, argv)
+    // It will throw exception if an option item is badly formatted or not configured
+    template<typename Handler>
+    void parse(std::istream &input, Handler &&handler, char delimiter = '\n') const;
+
+    // Returns the slot of configured @arg (short or long option without '-'), @npos if it is not configured
+    // Slots are stable, these are assigned in the order in which arguments are added
+    std::size_t slotOf(const std::string &arg) const noexcept;
+
+    // As the first command line argument is always application path, it returns the same
+    const std::string &getAppPath() const noexcept;
+
+    // To retrieve value corresponding to @arg
+    // If returned value is std::nullopt, it could be because:
+    //  - @arg was not configured/passed
+    //  - conversion from std::string to type T failed
+    // All values of arguments are stored as std::string, hence conversion to std::string always succeeds
+    // throws iff it is called before calling parse()
+    template<typename T = std::string>
+    std::optional<T> retrieve(const std::string &arg) const;
+
+    // Retrieves the value for @arg and throws if:
+    //   - conversion to type T fails
+    //   - the arg was not configured/passed
+    //   - this was called before parse()
+    template<typename T = std::string>
+    T retrieveMayThrow(const std::string &arg) const;
+
+    // Same as above, but through a handle, so the value is read directly from the slot of the argument
+    // A handle of another ArgParser, with a slot which isn't configured here, is treated as an unknown argument
+    template<typename T>
+    std::optional<T> retrieve(Opt<T> opt) const;
+
+    template<typename T>
+    T retrieveMayThrow(Opt<T> opt) const;
+
+    // To get the help message for this application with configured arguments
+    std::string helpMsg() const noexcept;
+
+    // Returns true if application was called with -h or --help
+    bool needHelp() const noexcept;
+
+    enum class Shell
+    {
+        Bash,
+        Zsh,
+        Fish
+    };
+
+    // To get a completion script for @shell, with all the configured arguments for @appName
+    // The shell completes from this list itself, so application isn't run on each <Tab> press
+    // It will throw exception if @appName is empty or has characters other than alphanumeric, '_', '.' and '-',
+    // as it is written into the script as it is
+    std::string completionScript(Shell shell, const std::string &appName) const;
+
+    // Returns true if application was called with `--complete <prefix>`
+    // In that case parse() only kept the prefix, and user should call @completionMsg and return
+    bool needCompletion() const noexcept;
+
+    // To get the sorted list of configured arguments which start with the prefix passed to `--complete`
+    // one per line, options which expect a value end with '='
+    std::string completionMsg() const;
+
+    // To get the description of application, the argument of the parameterized constructor
+    const std::string &getDescription() const noexcept;
+
+    // Returns true if the application was run with @arg as one of command line arguments
+    bool contains(const std::string &arg) const noexcept;
+
+    // Serializes the parsed values, including the applied defaults, and app path into a compact binary blob
+    // The blob can be written to a file and read by other processes through @ArgSnapshot, without parsing again
+    // throws iff it is called before calling parse() or if application was run with -h or --help
+    // or std::length_error if the blob would be larger than 4 GiB, as its offsets and sizes are 32 bit
+    std::string snapshot() const;
+
+    // 128 bit hash of a configuration, @low alone is a 64 bit one
+    struct Fingerprint
+    {
+        std::uint64_t low{0};
+        std::uint64_t high{0};
+
+        bool operator==(const Fingerprint &other) const noexcept;
+
+        bool operator!=(const Fingerprint &other) const noexcept;
+
+        // 32 hex digits, @high first
+        [[nodiscard]] std::string toHex() const;
+    };
+
+    // Hash of the effective configuration e.g. to be the key of cached outputs of the application
+    // Effective configuration is the long option and value of every argument which has a value, passed or from
+    // overrides or default values, except the ones excluded by @excludeFromFingerprint
+    // It doesn't depend on the order of command line arguments, nor on the order arguments were configured in
+    // Hashes of arguments are added up, so it takes a pass over arguments without sorting or allocation
+    // It isn't meant to resist deliberately crafted collisions
+    // throws iff it is called before calling parse() or if application was run with -h or --help
+    Fingerprint fingerprint() const;
+
+    // Same configuration as text e.g. to log it, a "long=value" line for each argument, sorted by long option
+    // '\' and new line in values are escaped as "\\" and "\n"
+    std::string canonicalConfig() const;
+
+    // Exports the configured arguments and constraints as JSON, e.g. for tools which check command lines of the
+    // application without running it, @ArgValidator validates command lines with it e.g.
+    //   {"description": "app", "arguments": [
+    //     {"short": "l", "long": "logfile", "help": "Log file", "mandatory": true},
+    //     {"short": "m", "long": "mode", "help": "run mode", "default": "fast", "choices": {"fast": 0, "safe": 1}},
+    //     {"short": "v", "long": "verbose", "help": "verbose logs", "affectsOutput": false}],
+    //    "constraints": [
+    //     {"kind": "mutuallyExclusive", "arguments": ["logfile", "mode"]},
+    //     {"kind": "atLeastOne", "arguments": ["logfile", "mode"]},
+    //     {"kind": "requires", "argument": "mode", "required": ["logfile"]}]}
+    // Values have no type, only choices have their mapped values, so the types of bound members are not exported
+    // and @ArgValidator doesn't find values which can't be converted to them
+    // "interpolation": true follows the description if @enableInterpolation was called
+    // The default help argument is not exported
+    std::string schemaJson() const;
+
+    // Configures an ArgParser as it was when @schemaJson returned @json
+    // It will throw exception if @json is not valid JSON in that format, or for the same reasons as @addArgument
+    static ArgParser fromSchemaJson(std::string_view json);
+
+    // The process wide ArgParser which every @ArgFlag is registered in, e.g. for its help message:
+    //   ArgParser::parseFlags(argc, argv);
+    //   if (ArgParser::flags().needHelp()) { std::cout << ArgParser::flags().helpMsg(); return 0; }
+    // It is created on first use, so flags of any translation unit can be registered before main
+    static const ArgParser &flags();
+
+    // Parses command line arguments with @flags, then publishes the value of every registered @ArgFlag
+    // It can only be called once, flags registered after it keep their default values and are not in @flags
+    // It will throw exception if:
+    //   - a flag couldn't be registered, e.g. it was a duplicate, as there was nobody to report it to at that time
+    //   - it was called before, even if that call has thrown
+    //   - for the same reasons as parse()
+    static void parseFlags(int argc, char *argv[]);
+
+private:
+    friend class ArgSnapshot;
+    friend class ArgOverlay;
+    friend class ArgValidator;
+    friend class LiveArgs;
+    template<typename T>
+    friend class ArgFlag;
+
+    // Layout of @snapshot, all integers are 32 bit little endian and offsets are from the start of blob:
+    //   header: magic, version, offset and size of app path, number of entries, list delimiter
+    //   entries: offset and size of short option, long option and value, 1 if the arg has choices or 0,
+    //            and the mapped value of choices as 64 bit (low half first), for each parsed arg
+    //   followed by all the strings
+    static constexpr std::string_view snapshotMagic{"ARGP"};
+    static constexpr std::uint32_t snapshotVersion{3};
+    static constexpr std::size_t snapshotHeaderSize{24};
+    static constexpr std::size_t snapshotEntrySize{36};
+
+    // Following is a set of helper classes and enum
+    // We don't need to expose these to the user, hence made them private
+    //  - little difficult to read and maintain, but better for user
+    //  - user just sees the public function of ArgParser
+    enum class ArgTypeEnum
+    {
+        Short,
+        Long,
+        Invalid
+    };
+
+    struct ParsedArg
+    {
+        ArgTypeEnum argType;
+        std::string parsedArg;
+
+        static ParsedArg parse_arg(std::string_view arg);
+    };
+
+    // A class which validates an argument before it is configured, then it is kept in @ArgTable
+    class Arg
+    {
+    public:
+
+        explicit Arg(const std::string &shortArg, const std::string &longArg, std::string helpMsg,
+                     bool isMandatory = false);
+
+        explicit Arg(const std::string &shortArg, const std::string &longArg, std::string helpMsg,
+                     std::string defaultValue);
+
+        [[nodiscard]] const std::string &getShortOpt() const noexcept;
+
+        [[nodiscard]] const std::string &getLongOpt() const noexcept;
+
+        [[nodiscard]] const std::string &getHelpMsg() const noexcept;
+
+        [[nodiscard]] bool hasDefaultValue() const noexcept;
+
+        // throws exception if no default value is set
+        [[nodiscard]] const std::string &getDefaultValue() const;
+
+        [[nodiscard]] std::string toString() const noexcept;
+
+        // Returns true if the argument is mandatory
+        [[nodiscard]] bool isMandatory() const noexcept;
+
+    private:
+        void init_args(const std::string &shortArg, const std::string &longArg);
+
+        std::string shortOpt{};
+        std::string longOpt{};
+        std::string helpMsg{};
+        std::string defaultValue{};
+        bool hasDefault{false};
+        bool mandatory{false};
+    };
+
+    // A string in a pool of strings
+    struct StringRef
+    {
+        std::uint32_t offset{0};
+        std::uint32_t size{0};
+    };
+
+    // All the configured arguments, as a structure of arrays indexed by slot
+    // Names, help messages and default values are kept in one contiguous pool, help messages and default values
+    // are interned so each distinct one is stored once (names are unique anyway)
+    // Short and long names are found through one open addressing table, whose buckets have a 32 bit entry and
+    // 32 bits of its hash, so that a lookup rarely needs to touch the strings
+    class ArgTable
+    {
+    public:
+        // It will throw exception if strings of all the arguments don't fit in 32 bit offsets
+        // @arg must be validated already, and its names must not be configured, returns its slot
+        std::size_t add(const Arg &arg);
+
+        // makes room for @count more arguments, whose strings are @stringSize long in total
+        void reserve(std::size_t count, std::size_t stringSize);
+
+        // removes the arguments after the first @slotCount ones
+        void truncate(std::size_t slotCount);
+
+        // for each of @names, index of the first one which is same as it, through a table sized for all of them
+        static std::vector<std::size_t> firstOccurrences(const std::vector<std::string_view> &names);
+
+        [[nodiscard]] std::size_t size() const noexcept;
+
+        // slot of the arg which has @name as short or long option, npos if there is none
+        [[nodiscard]] std::size_t find(std::string_view name) const noexcept;
+
+        // same as above, but @name must also be of @type
+        [[nodiscard]] std::size_t find(std::string_view name, ArgTypeEnum type) const noexcept;
+
+        [[nodiscard]] std::string_view shortOpt(std::size_t slot) const noexcept;
+
+        [[nodiscard]] std::string_view longOpt(std::size_t slot) const noexcept;
+
+        [[nodiscard]] std::string_view helpMsg(std::size_t slot) const noexcept;
+
+        [[nodiscard]] bool hasDefaultValue(std::size_t slot) const noexcept;
+
+        // empty if there is no default value
+        [[nodiscard]] std::string_view defaultValue(std::size_t slot) const noexcept;
+
+        [[nodiscard]] bool isMandatory(std::size_t slot) const noexcept;
+
+        // false for arguments excluded from the fingerprint
+        [[nodiscard]] bool affectsOutput(std::size_t slot) const noexcept;
+
+        void excludeFromOutput(std::size_t slot) noexcept;
+
+        [[nodiscard]] std::string toString(std::size_t slot) const noexcept;
+
+        [[nodiscard]] std::string toVerboseString(std::size_t slot) const noexcept;
+
+    private:
+        static constexpr std::uint8_t HasDefault{1u};
+        static constexpr std::uint8_t Mandatory{2u};
+        static constexpr std::uint8_t NotAffectingOutput{4u};
+
+        // returns the reference of @str in @pool, adds it only if it isn't there already
+        StringRef intern(std::string_view str);
+
+        // adds @str to @pool, throws if it doesn't fit in 32 bit offsets
+        StringRef append(std::string_view str);
+
+        [[nodiscard]] std::string_view view(StringRef ref) const noexcept;
+
+        // name of an entry in @nameBuckets, which is (slot << 1 | isLong) + 1
+        [[nodiscard]] std::string_view nameOf(std::uint32_t entry) const noexcept;
+
+        // a bucket has hash of the key in higher 32 bits and entry in lower ones, entry is never 0
+        static constexpr std::uint64_t bucketOf(std::uint64_t hash, std::uint32_t entry) noexcept;
+
+        static constexpr std::uint32_t entryOf(std::uint64_t bucket) noexcept;
+
+        // returns the bucket which has the entry whose key is @key (hashed as @hash), or the empty one where it
+        // should go, @keyOf gives the key of an entry, buckets must never be full
+        template<typename KeyOf>
+        static std::size_t probe(const std::vector<std::uint64_t> &buckets, std::string_view key, std::uint64_t hash,
+                                 KeyOf keyOf);
+
+        // doubles the buckets, when they are half full, and puts back all the entries
+        static void growIfNeeded(std::vector<std::uint64_t> &buckets, std::size_t entryCount);
+
+        // puts @bucket in the first empty one from where its hash points, without comparing keys
+        // so its key must not be in @buckets already
+        static void insertNew(std::vector<std::uint64_t> &buckets, std::uint64_t bucket) noexcept;
+
+        std::string pool{};
+        std::vector<StringRef> shortOpts{};
+        std::vector<StringRef> longOpts{};
+        std::vector<StringRef> helpMsgs{};
+        std::vector<StringRef> defaultValues{};
+        std::vector<std::uint8_t> flags{};
+
+        std::vector<StringRef> interned{};           // distinct help messages and default values in @pool
+        std::vector<std::uint64_t> internBuckets{};  // entry is index in @interned plus one, 0 if bucket is empty
+        std::vector<std::uint64_t> nameBuckets{};    // entry is described in @nameOf, 0 if bucket is empty
+    };
+
+    // FNV-1a followed by a mix, so that low bits depend on all of @str
+    static constexpr std::uint64_t hashString(std::string_view str, std::uint64_t seed = 0) noexcept;
+
+    static constexpr std::size_t slotsPerWord{64};
+
+    // A set of configured arguments, a bit for each slot
+    class SlotSet
+    {
+    public:
+        explicit SlotSet(std::size_t slotCount = 0);
+
+        void set(std::size_t slot);
+
+        [[nodiscard]] bool test(std::size_t slot) const noexcept;
+
+        [[nodiscard]] std::uint64_t word(std::size_t index) const noexcept;
+
+    private:
+        std::vector<std::uint64_t> words{};
+    };
+
+    // A rule over a set of configured arguments, compiled into a bit mask of their slots
+    // The mask only has the words starting at @firstWord which have any of those slots, so checking it
+    // doesn't depend on how many arguments are configured
+    struct Constraint
+    {
+        enum class Kind
+        {
+            AllOf,       // mandatory arguments or requirements of @trigger
+            AtMostOne,
+            AtLeastOne
+        };
+
+        Kind kind;
+        std::size_t trigger{npos}; // if set, the constraint applies only if this slot was passed
+        std::size_t firstWord{0};
+        std::vector<std::uint64_t> mask{};
+
+        void add(std::size_t slot);
+    };
+
+    // Allowed values of an argument and the values these map to
+    // Values are looked up through a perfect hash (hash and displace), which is built once when argument is added,
+    // so a lookup is two hashes and a single string comparison, however many choices there are
+    class Choices
+    {
+    public:
+        explicit Choices(std::vector<std::pair<std::string, std::int64_t>> choices);
+
+        // returns the mapped value of @name, std::nullopt if it is not one of the choices
+        [[nodiscard]] std::optional<std::int64_t> find(std::string_view name) const noexcept;
+
+        // comma separated list of allowed values, for messages
+        [[nodiscard]] std::string allowed() const noexcept;
+
+        [[nodiscard]] const std::vector<std::pair<std::string, std::int64_t>> &all() const noexcept;
+
+    private:
+        // places all the names in @slots, returns false if a displacement couldn't be found for some bucket
+        bool build(std::size_t slotCount);
+
+        std::vector<std::pair<std::string, std::int64_t>> choices;
+        std::vector<std::uint32_t> displacements{}; // seed of second hash, for each bucket of first hash
+        std::vector<std::uint32_t> slots{};         // index in @choices plus one, 0 if slot is empty
+    };
+
+    // A value read by @JsonReader, the parts which don't apply to its type are empty
+    struct JsonValue
+    {
+        enum class Type
+        {
+            Null,
+            Bool,
+            Number,
+            String,
+            Array,
+            Object
+        };
+
+        Type type{Type::Null};
+        bool boolean{false};
+        std::string text{};              // of a string, or of a number as it was written
+        std::vector<JsonValue> items{};  // of an array, or values of an object
+        std::vector<std::string> keys{}; // of an object, same order as @items
+
+        // value of @key in an object, nullptr if there is no such key
+        [[nodiscard]] const JsonValue *find(std::string_view key) const noexcept;
+    };
+
+    // Just enough of a JSON parser (RFC 8259) to read back @schemaJson, it throws on anything which isn't valid
+    class JsonReader
+    {
+    public:
+        explicit JsonReader(std::string_view json);
+
+        // the whole of json must be a single value
+        JsonValue read();
+
+    private:
+        // nesting is bounded, so that a hostile input can't overflow the stack
+        static constexpr std::size_t maxDepth{64};
+
+        JsonValue readValue(std::size_t depth);
+
+        std::string readString();
+
+        std::string readNumber();
+
+        // reads the 4 hex digits of a unicode escape
+        std::uint32_t readCodeUnit();
+
+        void skipSpaces() noexcept;
+
+        // skips @token if json continues with it
+        bool consume(std::string_view token) noexcept;
+
+        [[noreturn]] void fail(std::string_view expected) const;
+
+        std::string_view json;
+        std::size_t pos{0};
+    };
+
+    // @str as a quoted and escaped JSON string
+    static std::string toJson(std::string_view str);
+
+    // enums and integers (except bool and char) can be retrieved as mapped values of choices
+    template<typename T>
+    static constexpr bool isChoiceType = std::is_enum_v<T> ||
+                                         (std::is_integral_v<T> && !std::is_same_v<T, bool> &&
+                                          !std::is_same_v<T, char>);
+
+    template<typename T>
+    ArgParser &addChoiceArgumentImpl(Arg &&arg, const std::vector<std::pair<std::string, T>> &choices);
+
+    // index in @argChoices for @slot, npos if it doesn't have choices
+    std::size_t choicesOf(std::size_t slot) const noexcept;
+
+    // throws if @slot has choices and @value is not one of those, returns the mapped value otherwise
+    std::optional<std::int64_t> resolveChoice(std::size_t slot, std::string_view value) const;
+
+    // To convert a type into std::string, can't be dependent on just std::string
+    // as it is callable only on numeric types
+    // a helper for @concatenate method
+    template<typename T>
+    static std::string to_string(T &&arg) noexcept;
+
+    // To concatenate strings, fmt::format would have been ideal
+    // but we need to keep this header only library
+    template<typename ...Ts>
+    static std::string concatenate(Ts &&...args) noexcept;
+
+    // preprocess to ensure that help works as expected
+    void init() noexcept;
+
+    // ensures that parse() was called or if there was application was called with -h or --help
+    void validateRetrieval() const;
+
+    // check if all the mandatory arguments have been passed and all constraints are satisfied, throws otherwise
+    void checkConstraints(const SlotSet &passed) const;
+
+    // throws if @constraint is not satisfied by @passed
+    void checkConstraint(const Constraint &constraint, const SlotSet &passed) const;
+
+    // To describe the slots of @constraint in error messages, only those in @filter if it is passed
+    std::string describeSlots(const Constraint &constraint, const SlotSet *filter = nullptr) const;
+
+    ArgParser &addConstraint(Constraint::Kind kind, const std::vector<std::string> &args, std::size_t trigger = npos);
+
+    // Same as @slotOf, but throws if @arg is not configured
+    std::size_t configuredSlotOf(const std::string &arg) const;
+
+    // parses a key=value pair, throws iff format is incorrect
+    // returned value is a view into @arg
+    static std::pair<ParsedArg, std::string_view> argValueParser(std::string_view arg);
+
+    // finds the slot of arg in the list of configured args, npos if there is no such arg
+    std::size_t findSlot(const ParsedArg &arg) const noexcept;
+
+    // JSON array of long options of the slots in @constraint
+    std::string constraintJson(const Constraint &constraint) const;
+
+    // adds an argument or a constraint of @fromSchemaJson
+    void addJsonArgument(const JsonValue &arg);
+
+    void addJsonConstraint(const JsonValue &constraint);
+
+    // helper for streaming @parse, handles one complete item
+    template<typename Handler>
+    void streamItem(std::string_view item, Handler &handler) const;
+
+    static bool isHelpString(const std::string &arg) noexcept;
+
+    static bool isCompletionString(const std::string &arg) noexcept;
+
+    // all the words which can be completed, sorted, help options as they are and others followed by '='
+    // only those which start with @prefix are returned, that is cheaper than sorting all of them
+    std::vector<std::string> completionWords(std::string_view prefix) const;
+
+    ArgParser &addArgumentImpl(Arg &&arg);
+
+    // throws if @arg is both mandatory and has a default value, or for the same reasons as Arg
+    static Arg specToArg(const ArgSpec &arg);
+
+    // message with errors of all of @args for @addArguments, empty if all of them can be added
+    std::string argumentErrors(const std::vector<ArgSpec> &args) const;
+
+    // To convert from std::string to type T
+    // Following is how it is different from std::from_string:
+    //  - conversion to bool from "true" or "false" is supported
+    //  - conversion to char succeeds only if arg.size() is 1
+    //  - of course, if T is std::string, arg is returned
+    //  - integers can be hexadecimal or binary with 0x or 0b prefix, after the sign
+    //  - std::chrono::duration, ByteSize, Count and Rate are converted from a number with a unit
+    // for all numerical types, the behavior is same as that of std::from_string
+    template<typename T>
+    static std::optional<T> from_string(std::string_view arg) noexcept;
+
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L && !defined(ARG_PARSER_BUILTIN_FLOAT_PARSER)
+    static constexpr bool hasFloatFromChars{true};
+#else
+    static constexpr bool hasFloatFromChars{false};
+#endif
+
+    // std::from_chars, or FloatParser for floating point types if the standard library doesn't have those
+    // long double is parsed as double by FloatParser
+    template<typename T>
+    static std::from_chars_result fromChars(const char *first, const char *last, T &value) noexcept;
+
+    template<typename T>
+    struct IsDuration : std::false_type
+    {
+    };
+
+    template<typename Rep, typename Period>
+    struct IsDuration<std::chrono::duration<Rep, Period>> : std::true_type
+    {
+    };
+
+    // A unit of quantities, which is @num / @den of the base unit
+    struct Unit
+    {
+        std::string_view name;
+        std::uint64_t num;
+        std::uint64_t den;
+    };
+
+    // the base unit is the first one
+    static constexpr Unit byteUnits[]{
+            {"B", 1, 1}, {"KiB", 1ull << 10u, 1}, {"MiB", 1ull << 20u, 1}, {"GiB", 1ull << 30u, 1},
+            {"TiB", 1ull << 40u, 1}, {"PiB", 1ull << 50u, 1}, {"EiB", 1ull << 60u, 1}, {"kB", 1000, 1},
+            {"MB", 1000000, 1}, {"GB", 1000000000, 1}, {"TB", 1000000000000, 1}, {"PB", 1000000000000000, 1},
+            {"EB", 1000000000000000000, 1}};
+    static constexpr Unit countUnits[]{
+            {"", 1, 1}, {"k", 1000, 1}, {"M", 1000000, 1}, {"G", 1000000000, 1}, {"T", 1000000000000, 1},
+            {"P", 1000000000000000, 1}, {"E", 1000000000000000000, 1}};
+    // in seconds
+    static constexpr Unit timeUnits[]{
+            {"s", 1, 1}, {"ns", 1, 1000000000}, {"us", 1, 1000000}, {"ms", 1, 1000}, {"min", 60, 1},
+            {"h", 3600, 1}, {"d", 86400, 1}};
+
+    // A number with a fractional part is @mantissa / @scale e.g. 1.25 is 125 / 100
+    struct Fixed
+    {
+        std::uint64_t mantissa;
+        std::uint64_t scale;
+    };
+
+    // the number at the start of @text, which is then left with the rest, i.e. the unit
+    static std::optional<Fixed> readFixed(std::string_view &text) noexcept;
+
+    // the one of @units named @name, nullptr if none of them is
+    template<std::size_t N>
+    static const Unit *findUnit(std::string_view name, const Unit (&units)[N]) noexcept;
+
+    // @number * @num / @den, if it is a whole number which fits in std::uint64_t
+    static std::optional<std::uint64_t> scaleExactly(Fixed number, std::uint64_t num, std::uint64_t den) noexcept;
+
+    // number with one of @units e.g. 64MiB, in the base unit
+    template<std::size_t N>
+    static std::optional<std::uint64_t> from_quantity(std::string_view arg, const Unit (&units)[N]) noexcept;
+
+    template<typename T>
+    static std::optional<T> from_duration(std::string_view arg) noexcept;
+
+    static std::optional<Rate> from_rate(std::string_view arg) noexcept;
+
+    // @value with the biggest of @units it is a whole number of, as parsed by @from_quantity
+    template<std::size_t N>
+    static std::string quantity_to_string(std::uint64_t value, const Unit (&units)[N]) noexcept;
+
+    template<typename T>
+    struct IsList : std::false_type
+    {
+    };
+
+    template<typename T>
+    struct IsList<std::vector<T>> : std::true_type
+    {
+    };
+
+    // To convert a list of values separated by @delimiter, each one is converted as by @from_string
+    // straight from @list, there is no substring for any element
+    // Conversion fails if any of the elements fails, an empty @list has no elements
+    template<typename T>
+    static std::optional<std::vector<T>> from_list(std::string_view list, char delimiter);
+
+    // number of @c in @str, it compares 8 bytes at a time within a 64 bit word, which is portable and a few times
+    // faster than comparing each byte, when compiler doesn't vectorize that
+    static std::size_t countOf(std::string_view str, char c) noexcept;
+
+    // To describe the app
+    std::string description;
+
+    // To keep the configured arguments, also ensures that names of configured arguments don't match with others
+    ArgTable configuredArgs{};
+
+    // choices of arguments added with those, @choicesIndex has index in @argChoices for each slot, npos otherwise
+    // @parsedChoices has the mapped value of each of @argChoices after parse()
+    std::vector<Choices> argChoices{};
+    std::vector<std::size_t> choicesIndex{};
+    std::vector<std::int64_t> parsedChoices{};
+
+    // mandatory arguments are checked like any other constraint
+    Constraint mandatoryArgs{Constraint::Kind::AllOf};
+    std::vector<Constraint> constraints{};
+
+    // Used to keep the values of configured arguments for each slot, as passed in command line arguments
+    // values are in @parsedPool, offset is @notParsed if the argument has no value
+    static constexpr std::uint32_t notParsed{UINT32_MAX};
+    std::string parsedPool{};
+    std::vector<StringRef> parsedArgs{};
+
+    // Values which are used when an argument is not passed, sorted by slot, these are only a few usually
+    std::vector<std::pair<std::size_t, std::string>> overrides{};
+
+    char listDelimiter{','};
+
+    // Values which reference other values or environment variables, see @enableInterpolation
+    // Their expansions are evaluated on first retrieval under @mutex, and published through @values, so the
+    // ones evaluated already are read without a lock
+    // A copy starts without any expansion evaluated, these belong to the values of the ArgParser they are in
+    class Expansions
+    {
+    public:
+        Expansions() = default;
+
+        Expansions(const Expansions &other);
+
+        Expansions &operator=(const Expansions &other);
+
+        // forgets the references and expansions, for @slotCount arguments
+        void reset(std::size_t slotCount);
+
+        void addReferences(std::size_t slot);
+
+        bool hasReferences(std::size_t slot) const noexcept;
+
+        // expansion of @slot, nullptr if it isn't evaluated yet
+        const std::string *find(std::size_t slot) const noexcept;
+
+        // keeps and publishes @expansion of @slot, @mutex must be locked
+        const std::string &store(std::size_t slot, std::string expansion) const;
+
+        bool enabled{false};
+        mutable std::mutex mutex{};
+
+    private:
+        std::vector<bool> references{};
+        std::unique_ptr<std::atomic<const std::string *>[]> values{};
+        mutable std::vector<std::unique_ptr<const std::string>> storage{};
+    };
+
+    Expansions expansions{};
+
+    static constexpr std::string_view envPrefix{"env:"};
+
+    // expansions of all the values together can be this many times longer than the values and the environment
+    // variables they reference, so that a few values which reference each other many times can't take a lot of
+    // memory e.g. --a=${b}${b} --b=${c}${c} ...
+    static constexpr std::size_t maxExpansionGrowth{64};
+
+    // value of @slot from the first source which has one: @parsedArgs, @overrides and then default value, which
+    // is expanded if it has references
+    // std::nullopt if none of them has it
+    // It will throw exception if the expansion can't be allocated, as it locks and allocates on the first retrieval
+    std::optional<std::string_view> parsedValue(std::size_t slot) const;
+
+    // same as @parsedValue, but references are not expanded
+    std::optional<std::string_view> rawValue(std::size_t slot) const noexcept;
+
+    // builds the graph of references of values at parse(), throws for unknown arguments and cycles
+    // No value is expanded after it has thrown, till it succeeds
+    void checkInterpolation();
+
+    // slots whose value from @rawValueOf has references, each one after the slots it references
+    // It will throw exception for unknown arguments, cycles and expansions longer than @maxExpansionGrowth allows
+    template<typename RawValueOf>
+    std::vector<std::size_t> referenceOrder(RawValueOf &&rawValueOf) const;
+
+    // @value with its references replaced, @valueOf is called with the name of each referenced argument
+    template<typename ValueOf>
+    static std::string expand(std::string_view value, ValueOf &&valueOf);
+
+    // evaluates all the values which have references, so that retrieving them later doesn't lock
+    void expandReferences() const;
+
+    // calls @onText with the text between references and @onReference with the name of each ${name}, in order
+    // returns false if a ${ is not closed
+    template<typename OnText, typename OnReference>
+    static bool scanReferences(std::string_view value, OnText &&onText, OnReference &&onReference);
+
+    // expansion of @value of @slot, evaluated when it is retrieved first
+    std::string_view interpolatedValue(std::size_t slot, std::string_view value) const;
+
+    // same as above, with @expansions.mutex locked, so that it can evaluate referenced values as well
+    const std::string &evaluate(std::size_t slot, std::string_view value) const;
+
+    // true if @slot has a value in @parsedArgs
+    bool isPassed(std::size_t slot) const noexcept;
+
+    // value of @slot from @overrides or default value
+    std::optional<std::string_view> fallbackValue(std::size_t slot) const noexcept;
+
+    // parses passed arguments and checks the constraints, but doesn't visit the other values
+    // returns the passed slots, std::nullopt if application was run for help or completion
+    template<typename Visitor>
+    std::optional<SlotSet> parsePassed(int argc, char *argv[], Visitor &visitor);
+
+    // value of @slot as T, for both @retrieve functions
+    template<typename T>
+    std::optional<T> retrieveSlot(std::size_t slot) const;
+
+    // @value of @slot as T, choices of @value are looked up unless parse() has resolved them already
+    template<typename T>
+    std::optional<T> convertSlot(std::size_t slot, std::string_view value, bool isResolved) const;
+
+    // A member bound by @addBoundArgument, @write converts the value of @slot and assigns it to @target
+    // @check throws if @write would throw, without writing anything
+    struct Binding
+    {
+        std::size_t slot;
+        void *target;
+        void (*check)(const ArgParser &argParser, std::size_t slot);
+        void (*write)(const ArgParser &argParser, std::size_t slot, void *target);
+    };
+
+    // in the order these were added
+    std::vector<Binding> bindings{};
+
+    // binds the argument added last to @target
+    template<typename T>
+    void bind(T &target);
+
+    // the value of @slot converted for a member of type T, std::nullopt if it has no value
+    // It will throw exception if the value can't be converted
+    template<typename T>
+    static std::optional<T> convertBound(const ArgParser &argParser, std::size_t slot);
+
+    // @Binding::check and @Binding::write for members of type T
+    template<typename T>
+    static void checkBound(const ArgParser &argParser, std::size_t slot);
+
+    template<typename T>
+    static void writeBound(const ArgParser &argParser, std::size_t slot, void *target);
+
+    // writes values of all @bindings at the end of parse(), or none of them if any can't be converted
+    void writeBindings() const;
+
+    // Behind @flags and @parseFlags, defined after ArgParser as it holds one
+    struct FlagRegistry;
+
+    static FlagRegistry &flagRegistry();
+
+    // adds @flag to @flagRegistry, errors are kept for @parseFlags to throw, as it runs before main
+    template<typename T>
+    static void registerFlag(ArgFlag<T> &flag, const std::string &shortOpt, const std::string &longOpt,
+                             const std::string &helpMsg) noexcept;
+
+    // @Binding::write for ArgFlag<T>, converts the value and publishes it
+    template<typename T>
+    static void publishFlag(const ArgParser &argParser, std::size_t slot, void *target);
+
+    std::string appPath{};
+    bool isOnlyHelpString{false};
+    std::optional<std::string> completionPrefix{};
+
+    static constexpr auto truthy = "true";
+    static constexpr auto falsy = "false";
+};
+
+inline
+ArgParser &ArgParser::addArgument(const std::string &shortOpt, const std::string &longOpt, const std::string &helpMsg,
+                                  bool isMandatory)
+{
+    return addArgumentImpl(Arg{shortOpt, longOpt, helpMsg, isMandatory});
+}
+
+template<typename T>
+ArgParser &ArgParser::addArgumentWithDefault(const std::string &shortOpt, const std::string &longOpt,
+                                             const std::string &helpMsg, const T &defaultValue)
+{
+    return addArgumentImpl(Arg{shortOpt, longOpt, helpMsg, to_string(defaultValue)});
+}
+
+template<typename T>
+ArgParser::Opt<T>::Opt(std::size_t slot) noexcept : index(slot)
+{}
+
+template<typename T>
+std::size_t ArgParser::Opt<T>::slot() const noexcept
+{
+    return index;
+}
+
+template<typename T>
+ArgParser::Opt<T> ArgParser::addTypedArgument(const std::string &shortOpt, const std::string &longOpt,
+                                              const std::string &helpMsg, bool isMandatory)
+{
+    addArgument(shortOpt, longOpt, helpMsg, isMandatory);
+    return Opt<T>{configuredArgs.size() - 1};
+}
+
+template<typename T>
+ArgParser::Opt<T> ArgParser::addTypedArgumentWithDefault(const std::string &shortOpt, const std::string &longOpt,
+                                                         const std::string &helpMsg, const T &defaultValue)
+{
+    static_assert(!std::is_array_v<T>, "type of a string literal must be passed e.g. <std::string>");
+    addArgumentWithDefault(shortOpt, longOpt, helpMsg, defaultValue);
+    return Opt<T>{configuredArgs.size() - 1};
+}
+
+template<typename T>
+ArgParser::Opt<T> ArgParser::optOf(const std::string &arg) const
+{
+    return Opt<T>{configuredSlotOf(arg)};
+}
+
+template<typename Config, typename T>
+ArgParser &ArgParser::addBoundArgument(const std::string &shortOpt, const std::string &longOpt,
+                                       const std::string &helpMsg, Config &config, T Config::*member,
+                                       bool isMandatory)
+{
+    addArgument(shortOpt, longOpt, helpMsg, isMandatory);
+    bind(config.*member);
+    return *this;
+}
+
+template<typename Config, typename T>
+ArgParser &ArgParser::addBoundArgumentWithDefault(const std::string &shortOpt, const std::string &longOpt,
+                                                  const std::string &helpMsg, Config &config, T Config::*member,
+                                                  const std::common_type_t<T> &defaultValue)
+{
+    addArgumentWithDefault(shortOpt, longOpt, helpMsg, defaultValue);
+    bind(config.*member);
+    return *this;
+}
+
+template<typename T>
+void ArgParser::bind(T &target)
+{
+    bindings.push_back(Binding{configuredArgs.size() - 1, &target, &checkBound<T>, &writeBound<T>});
+}
+
+template<typename T>
+std::optional<T> ArgParser::convertBound(const ArgParser &argParser, std::size_t slot)
+{
+    const auto value = argParser.parsedValue(slot);
+    if (!value)
+    {
+        return std::nullopt;
+    }
+    auto converted = argParser.retrieveSlot<T>(slot);
+    if (!converted)
+    {
+        throw std::runtime_error{concatenate("Invalid value [", *value, "] for [",
+                                             argParser.configuredArgs.toString(slot),
+                                             "], it can't be converted to its bound member")};
+    }
+    return converted;
+}
+
+template<typename T>
+void ArgParser::checkBound(const ArgParser &argParser, std::size_t slot)
+{
+    convertBound<T>(argParser, slot);
+}
+
+template<typename T>
+void ArgParser::writeBound(const ArgParser &argParser, std::size_t slot, void *target)
+{
+    if (auto converted = convertBound<T>(argParser, slot))
+    {
+        *static_cast<T *>(target) = std::move(*converted);
+    }
+}
+
+inline
+void ArgParser::writeBindings() const
+{
+    // all of them are converted once before writing, so that a failure doesn't leave members half updated
+    for (const auto &binding : bindings)
+    {
+        binding.check(*this, binding.slot);
+    }
+    for (const auto &binding : bindings)
+    {
+        binding.write(*this, binding.slot, binding.target);
+    }
+}
+
+// @mutex guards the rest till @parsed is set, nothing changes after that
+struct ArgParser::FlagRegistry
+{
+    std::mutex mutex{};
+    ArgParser argParser{};
+    std::vector<Binding> flags{}; // write publishes the value into an ArgFlag
+    std::vector<std::string> errors{};
+    bool parsed{false};
+};
+
+inline
+ArgParser::FlagRegistry &ArgParser::flagRegistry()
+{
+    // constructed by whichever flag is registered first, whatever the order of static initialization is
+    static FlagRegistry registry{};
+    return registry;
+}
+
+inline
+const ArgParser &ArgParser::flags()
+{
+    return flagRegistry().argParser;
+}
+
+inline
+void ArgParser::parseFlags(int argc, char *argv[])
+{
+    auto &registry = flagRegistry();
+    std::lock_guard<std::mutex> lock{registry.mutex};
+    if (registry.parsed)
+    {
+        throw std::runtime_error{"Flags can only be parsed once"};
+    }
+    if (!registry.errors.empty())
+    {
+        std::string message{"Couldn't register flags:"};
+        for (const auto &error : registry.errors)
+        {
+            message.append("\n  ").append(error);
+        }
+        throw std::runtime_error{message};
+    }
+    // flags registered after this are ignored, @flags() might be read without the lock from now on
+    registry.parsed = true;
+    registry.argParser.parse(argc, argv);
+    if (!registry.argParser.needHelp() && !registry.argParser.needCompletion())
+    {
+        // no flag is published, if any of them can't be converted
+        for (const auto &flag : registry.flags)
+        {
+            flag.check(registry.argParser, flag.slot);
+        }
+        for (const auto &flag : registry.flags)
+        {
+            flag.write(registry.argParser, flag.slot, flag.target);
+        }
+    }
+}
+
+template<typename T>
+void ArgParser::registerFlag(ArgFlag<T> &flag, const std::string &shortOpt, const std::string &longOpt,
+                             const std::string &helpMsg) noexcept
+{
+    auto &registry = flagRegistry();
+    std::lock_guard<std::mutex> lock{registry.mutex};
+    if (registry.parsed)
+    {
+        return; // e.g. of a library loaded later, readers might be using @registry.argParser already
+    }
+    try
+    {
+        registry.argParser.addArgumentWithDefault(shortOpt, longOpt, helpMsg, flag.defaultValue);
+        registry.flags.push_back(Binding{registry.argParser.configuredArgs.size() - 1, &flag, &checkBound<T>,
+                                                 &publishFlag<T>});
+    }
+    catch (const std::exception &e)
+    {
+        registry.errors.emplace_back(e.what());
+    }
+}
+
+template<typename T>
+void ArgParser::publishFlag(const ArgParser &argParser, std::size_t slot, void *target)
+{
+    auto &flag = *static_cast<ArgFlag<T> *>(target);
+    writeBound<T>(argParser, slot, &flag.parsedValue);
+    // readers which see the new pointer, see the value written above
+    flag.current.store(&flag.parsedValue, std::memory_order_release);
+}
+
+inline
+ArgParser &ArgParser::addArgumentImpl(Arg &&arg)
+{
+    if (configuredArgs.find(arg.getShortOpt()) != npos || configuredArgs.find(arg.getLongOpt()) != npos)
+    {
+        throw std::runtime_error{concatenate("Duplicate arguments: ", arg.toString())};
+    }
+    const auto slot = configuredArgs.add(arg);
+    if (arg.isMandatory())
+    {
+        mandatoryArgs.add(slot);
+    }
+    return *this;
+}
+
+inline
+ArgParser &ArgParser::addArguments(const std::vector<ArgSpec> &args)
+{
+    std::size_t stringSize{0};
+    for (const auto &arg : args)
+    {
+        stringSize += arg.shortOpt.size() + arg.longOpt.size() + arg.helpMsg.size() +
+                      (arg.defaultValue ? arg.defaultValue->size() : 0);
+    }
+
+    // arguments are added as they are validated, if any of them can't be added, all of them are removed and
+    // then errors of all of them are found, which is slower but only happens once
+    const auto slotCount = configuredArgs.size();
+    const auto configuredMandatoryArgs = mandatoryArgs;
+    configuredArgs.reserve(args.size(), stringSize);
+    try
+    {
+        for (const auto &arg : args)
+        {
+            addArgumentImpl(specToArg(arg));
+        }
+    }
+    catch (const std::runtime_error &)
+    {
+        configuredArgs.truncate(slotCount);
+        mandatoryArgs = configuredMandatoryArgs;
+        const auto errors = argumentErrors(args);
+        if (errors.empty())
+        {
+            throw;
+        }
+        throw std::runtime_error{errors};
+    }
+    return *this;
+}
+
+inline
+ArgParser::Arg ArgParser::specToArg(const ArgSpec &arg)
+{
+    if (arg.defaultValue && arg.isMandatory)
+    {
+        throw std::runtime_error{
+                concatenate("Mandatory argument [", arg.shortOpt, ", ", arg.longOpt, "] can't have a default value")};
+    }
+    return arg.defaultValue ? Arg{arg.shortOpt, arg.longOpt, arg.helpMsg, *arg.defaultValue}
+                            : Arg{arg.shortOpt, arg.longOpt, arg.helpMsg, arg.isMandatory};
+}
+
+inline
+std::string ArgParser::argumentErrors(const std::vector<ArgSpec> &args) const
+{
+    std::vector<std::string> errors{};
+    std::vector<Arg> validArgs{};
+    validArgs.reserve(args.size());
+    for (const auto &arg : args)
+    {
+        try
+        {
+            validArgs.push_back(specToArg(arg));
+        }
+        catch (const std::runtime_error &e)
+        {
+            errors.emplace_back(e.what());
+        }
+    }
+
+    // short and long names of each argument, and the first name which is same as each of them
+    std::vector<std::string_view> names{};
+    names.reserve(2 * validArgs.size());
+    for (const auto &arg : validArgs)
+    {
+        names.emplace_back(arg.getShortOpt());
+        names.emplace_back(arg.getLongOpt());
+    }
+    const auto firstOf = ArgTable::firstOccurrences(names);
+    std::vector<std::size_t> sameNames(names.size(), 0);
+    for (std::size_t i = 0; i < names.size(); ++i)
+    {
+        ++sameNames[firstOf[i]];
+    }
+    for (std::size_t i = 0; i < names.size(); ++i)
+    {
+        const auto configuredSlot = firstOf[i] == i ? configuredArgs.find(names[i]) : npos;
+        if (firstOf[i] != i || (sameNames[i] == 1 && configuredSlot == npos))
+        {
+            continue;
+        }
+        auto conflict = concatenate("Duplicate argument [", names[i], "] in: ");
+        auto separator = "";
+        if (configuredSlot != npos)
+        {
+            conflict += concatenate('[', configuredArgs.toString(configuredSlot), ']');
+            separator = ", ";
+        }
+        for (auto j = i; j < names.size(); ++j)
+        {
+            if (firstOf[j] == i)
+            {
+                conflict += concatenate(std::exchange(separator, ", "), '[', validArgs[j / 2].toString(), ']');
+            }
+        }
+        errors.push_back(std::move(conflict));
+    }
+
+    if (errors.empty())
+    {
+        return {};
+    }
+    std::string message{"Couldn't add arguments:"};
+    for (const auto &error : errors)
+    {
+        message += concatenate("\n  ", error);
+    }
+    return message;
+}
+
+template<typename T>
+ArgParser &ArgParser::addChoiceArgument(const std::string &shortOpt, const std::string &longOpt,
+                                        const std::string &helpMsg,
+                                        const std::vector<std::pair<std::string, T>> &choices, bool isMandatory)
+{
+    return addChoiceArgumentImpl(Arg{shortOpt, longOpt, helpMsg, isMandatory}, choices);
+}
+
+template<typename T>
+ArgParser &ArgParser::addChoiceArgumentWithDefault(const std::string &shortOpt, const std::string &longOpt,
+                                                   const std::string &helpMsg,
+                                                   const std::vector<std::pair<std::string, T>> &choices,
+                                                   const std::string &defaultChoice)
+{
+    return addChoiceArgumentImpl(Arg{shortOpt, longOpt, helpMsg, defaultChoice}, choices);
+}
+
+template<typename T>
+ArgParser &ArgParser::addChoiceArgumentImpl(Arg &&arg, const std::vector<std::pair<std::string, T>> &choices)
+{
+    static_assert(isChoiceType<T>, "choices can only be mapped to enums or integers");
+
+    std::vector<std::pair<std::string, std::int64_t>> mappedChoices{};
+    mappedChoices.reserve(choices.size());
+    using Underlying = typename std::conditional_t<std::is_enum_v<T>, std::underlying_type<T>,
+                                                   std::common_type<T>>::type;
+    for (const auto &choice : choices)
+    {
+        const auto value = static_cast<Underlying>(choice.second);
+        if constexpr (std::is_unsigned_v<Underlying> && sizeof(Underlying) >= sizeof(std::int64_t))
+        {
+            // mapped values are kept as std::int64_t, larger ones would wrap around
+            if (value > static_cast<Underlying>(std::numeric_limits<std::int64_t>::max()))
+            {
+                throw std::runtime_error{concatenate("Value of choice [", choice.first, "] of [", arg.toString(),
+                                                     "] is too large, it must fit in std::int64_t")};
+            }
+        }
+        mappedChoices.emplace_back(choice.first, static_cast<std::int64_t>(value));
+    }
+
+    Choices argChoice{std::move(mappedChoices)};
+    if (arg.hasDefaultValue() && !argChoice.find(arg.getDefaultValue()))
+    {
+        throw std::runtime_error{concatenate("Default value [", arg.getDefaultValue(), "] of [", arg.toString(),
+                                             "] is not one of: ", argChoice.allowed())};
+    }
+
+    addArgumentImpl(std::move(arg));
+    const auto slot = configuredArgs.size() - 1;
+    choicesIndex.resize(slot + 1, npos);
+    choicesIndex[slot] = argChoices.size();
+    argChoices.emplace_back(std::move(argChoice));
+    parsedChoices.resize(argChoices.size(), 0);
+    return *this;
+}
+
+inline
+std::size_t ArgParser::choicesOf(std::size_t slot) const noexcept
+{
+    return slot < choicesIndex.size() ? choicesIndex[slot] : npos;
+}
+
+inline
+std::optional<std::int64_t> ArgParser::resolveChoice(std::size_t slot, std::string_view value) const
+{
+    const auto index = choicesOf(slot);
+    if (index == npos)
+    {
+        return std::nullopt;
+    }
+
+    const auto mapped = argChoices[index].find(value);
+    if (!mapped)
+    {
+        throw std::runtime_error{concatenate("Invalid value [", value, "] for [", configuredArgs.toString(slot),
+                                             "], allowed values are: ", argChoices[index].allowed())};
+    }
+    return mapped;
+}
+
+template<typename T>
+ArgParser &ArgParser::setOverride(const std::string &arg, const T &value)
+{
+    const auto slot = configuredSlotOf(arg);
+    auto str = to_string(value);
+    resolveChoice(slot, str);
+
+    const auto it = std::lower_bound(overrides.begin(), overrides.end(), slot, [](const auto &override, auto key)
+    {
+        return override.first < key;
+    });
+    const auto isSet = it != overrides.end() && it->first == slot;
+    auto previous = isSet ? std::exchange(it->second, std::move(str)) : std::string{};
+    const auto entry = isSet ? it : overrides.emplace(it, slot, std::move(str));
+    if (expansions.enabled && !parsedArgs.empty())
+    {
+        // the value might reference others, or be referenced
+        try
+        {
+            checkInterpolation();
+        }
+        catch (const std::runtime_error &)
+        {
+            // the earlier values were valid
+            if (isSet)
+            {
+                entry->second = std::move(previous);
+            }
+            else
+            {
+                overrides.erase(entry);
+            }
+            checkInterpolation();
+            throw;
+        }
+    }
+    return *this;
+}
+
+inline
+ArgParser &ArgParser::excludeFromFingerprint(const std::vector<std::string> &args)
+{
+    std::vector<std::size_t> slots{};
+    slots.reserve(args.size());
+    std::transform(args.cbegin(), args.cend(), std::back_inserter(slots), [this](const std::string &arg)
+    {
+        return configuredSlotOf(arg);
+    });
+    for (const auto slot : slots)
+    {
+        configuredArgs.excludeFromOutput(slot);
+    }
+    return *this;
+}
+
+inline
+ArgParser &ArgParser::clearOverrides()
+{
+    auto previous = std::move(overrides);
+    overrides.clear();
+    if (expansions.enabled && !parsedArgs.empty())
+    {
+        // overrides might have replaced values which reference each other
+        try
+        {
+            checkInterpolation();
+        }
+        catch (const std::runtime_error &)
+        {
+            // the earlier values were valid
+            overrides = std::move(previous);
+            checkInterpolation();
+            throw;
+        }
+    }
+    return *this;
+}
+
+inline
+ArgParser &ArgParser::enableInterpolation() noexcept
+{
+    expansions.enabled = true;
+    return *this;
+}
+
+inline
+ArgParser::Expansions::Expansions(const Expansions &other) : enabled(other.enabled)
+{
+    reset(other.references.size());
+    references = other.references;
+}
+
+inline
+ArgParser::Expansions &ArgParser::Expansions::operator=(const Expansions &other)
+{
+    if (this != &other)
+    {
+        enabled = other.enabled;
+        reset(other.references.size());
+        references = other.references;
+    }
+    return *this;
+}
+
+inline
+void ArgParser::Expansions::reset(std::size_t slotCount)
+{
+    references.assign(slotCount, false);
+    values = slotCount == 0 ? nullptr : std::make_unique<std::atomic<const std::string *>[]>(slotCount);
+    storage.clear();
+}
+
+inline
+void ArgParser::Expansions::addReferences(std::size_t slot)
+{
+    references[slot] = true;
+}
+
+inline
+bool ArgParser::Expansions::hasReferences(std::size_t slot) const noexcept
+{
+    return slot < references.size() && references[slot];
+}
+
+inline
+const std::string *ArgParser::Expansions::find(std::size_t slot) const noexcept
+{
+    return values[slot].load(std::memory_order_acquire);
+}
+
+inline
+const std::string &ArgParser::Expansions::store(std::size_t slot, std::string expansion) const
+{
+    // strings are not moved when @storage grows, readers might hold views of the published ones
+    const auto &stored = storage.emplace_back(std::make_unique<const std::string>(std::move(expansion)));
+    values[slot].store(stored.get(), std::memory_order_release);
+    return *stored;
+}
+
+inline
+void ArgParser::checkInterpolation()
+{
+    expansions.reset(0); // references of the earlier values might close a cycle now, so none are followed
+    const auto order = referenceOrder([this](std::size_t slot) { return rawValue(slot); });
+    expansions.reset(configuredArgs.size());
+    for (const auto slot : order)
+    {
+        expansions.addReferences(slot);
+    }
+}
+
+template<typename RawValueOf>
+std::vector<std::size_t> ArgParser::referenceOrder(RawValueOf &&rawValueOf) const
+{
+    std::vector<bool> hasReferences(configuredArgs.size(), false);
+    std::vector<std::vector<std::size_t>> dependencies(configuredArgs.size());
+    // sizes of values, and of the text and environment variables in values, to limit the size of expansions
+    std::vector<std::size_t> sizes(configuredArgs.size(), 0);
+    std::size_t inputSize{0};
+    for (std::size_t slot = 0; slot < configuredArgs.size(); ++slot)
+    {
+        const auto value = rawValueOf(slot);
+        sizes[slot] = value ? value->size() : 0;
+        inputSize += sizes[slot];
+        if (!value || value->find('$') == std::string_view::npos || choicesOf(slot) != npos)
+        {
+            continue;
+        }
+        hasReferences[slot] = true;
+        sizes[slot] = 0;
+        const auto closed = scanReferences(*value, [&](std::string_view text) { sizes[slot] += text.size(); },
+                                           [&](std::string_view name)
+        {
+            if (name.substr(0, envPrefix.size()) == envPrefix)
+            {
+                if (const char *env = std::getenv(std::string{name.substr(envPrefix.size())}.c_str()))
+                {
+                    sizes[slot] += std::strlen(env);
+                    inputSize += std::strlen(env);
+                }
+                return;
+            }
+            const auto dependency = slotOf(std::string{name});
+            if (dependency == npos)
+            {
+                throw std::runtime_error{concatenate("Invalid value [", *value, "] for [",
+                                                     configuredArgs.toString(slot), "], unknown argument: ", name)};
+            }
+            dependencies[slot].push_back(dependency);
+        });
+        if (!closed)
+        {
+            throw std::runtime_error{concatenate("Invalid value [", *value, "] for [", configuredArgs.toString(slot),
+                                                 "], ${ is not closed")};
+        }
+    }
+
+    // depth first search, a slot which is reached again while it is on the path closes a cycle
+    // sizes of expansions are added up in post order, as these are sums of the sizes of references
+    const auto expansionLimit = maxExpansionGrowth * std::max<std::size_t>(inputSize, 1);
+    std::size_t expansionSize{0};
+    enum class State : std::uint8_t
+    {
+        Unvisited,
+        OnPath,
+        Done
+    };
+    std::vector<State> states(configuredArgs.size(), State::Unvisited);
+    std::vector<std::size_t> order{};
+    std::vector<std::pair<std::size_t, std::size_t>> path{}; // slot and its next dependency to visit
+    for (std::size_t start = 0; start < configuredArgs.size(); ++start)
+    {
+        if (states[start] != State::Unvisited)
+        {
+            continue;
+        }
+        states[start] = State::OnPath;
+        path.emplace_back(start, 0);
+        while (!path.empty())
+        {
+            auto &[slot, next] = path.back();
+            if (next == dependencies[slot].size())
+            {
+                for (const auto dependency : dependencies[slot])
+                {
+                    // saturates, so that sizes which double with each reference can't overflow
+                    const auto size = sizes[slot] + std::min(sizes[dependency], expansionLimit);
+                    sizes[slot] = std::min(size, expansionLimit + 1);
+                }
+                expansionSize += hasReferences[slot] ? sizes[slot] : 0;
+                if (expansionSize > expansionLimit)
+                {
+                    throw std::runtime_error{concatenate("Invalid value [", *rawValueOf(slot), "] for [",
+                                                         configuredArgs.toString(slot), "], expansions of values ",
+                                                         "would be longer than ", maxExpansionGrowth,
+                                                         " times the values")};
+                }
+                if (hasReferences[slot])
+                {
+                    order.push_back(slot);
+                }
+                states[slot] = State::Done;
+                path.pop_back();
+                continue;
+            }
+            const auto dependency = dependencies[slot][next++];
+            if (states[dependency] == State::OnPath)
+            {
+                auto it = std::find_if(path.cbegin(), path.cend(), [dependency](const auto &entry)
+                {
+                    return entry.first == dependency;
+                });
+                std::string cycle{};
+                for (; it != path.cend(); ++it)
+                {
+                    cycle.append("[").append(configuredArgs.toString(it->first)).append("] -> ");
+                }
+                throw std::runtime_error{concatenate("Cyclic interpolation: ", cycle, '[',
+                                                     configuredArgs.toString(dependency), ']')};
+            }
+            if (states[dependency] == State::Unvisited)
+            {
+                states[dependency] = State::OnPath;
+                path.emplace_back(dependency, 0);
+            }
+        }
+    }
+    return order;
+}
+
+template<typename OnText, typename OnReference>
+bool ArgParser::scanReferences(std::string_view value, OnText &&onText, OnReference &&onReference)
+{
+    while (!value.empty())
+    {
+        const auto dollar = value.find('$');
+        onText(value.substr(0, dollar));
+        if (dollar == std::string_view::npos)
+        {
+            break;
+        }
+        value.remove_prefix(dollar);
+        if (value.size() > 1 && value[1] == '{')
+        {
+            const auto close = value.find('}');
+            if (close == std::string_view::npos)
+            {
+                return false;
+            }
+            onReference(value.substr(2, close - 2));
+            value.remove_prefix(close + 1);
+        }
+        else
+        {
+            // "$$" is a '$', and so is a '$' which isn't followed by '{'
+            onText(value.substr(0, 1));
+            value.remove_prefix(value.size() > 1 && value[1] == '$' ? 2 : 1);
+        }
+    }
+    return true;
+}
+
+inline
+std::string_view ArgParser::interpolatedValue(std::size_t slot, std::string_view value) const
+{
+    if (const auto *expansion = expansions.find(slot))
+    {
+        return *expansion;
+    }
+    std::lock_guard<std::mutex> lock{expansions.mutex};
+    return evaluate(slot, value);
+}
+
+inline
+const std::string &ArgParser::evaluate(std::size_t slot, std::string_view value) const
+{
+    // references are evaluated before the values which reference them, in post order without recursion, as a
+    // chain of references can be as long as there are arguments
+    // checkInterpolation has rejected cycles and unknown arguments
+    std::vector<std::pair<std::size_t, bool>> pending{{slot, false}}; // and if its references are evaluated
+    while (!pending.empty())
+    {
+        const auto [current, isReady] = pending.back();
+        pending.pop_back();
+        if (expansions.find(current))
+        {
+            continue; // evaluated by another thread, or as a reference of another value
+        }
+        const auto currentValue = current == slot ? value : *rawValue(current);
+        if (!isReady)
+        {
+            pending.emplace_back(current, true);
+            scanReferences(currentValue, [](std::string_view) {}, [this, &pending](std::string_view name)
+            {
+                const auto isEnv = name.substr(0, envPrefix.size()) == envPrefix;
+                const auto dependency = isEnv ? npos : slotOf(std::string{name});
+                if (expansions.hasReferences(dependency) && !expansions.find(dependency))
+                {
+                    pending.emplace_back(dependency, false);
+                }
+            });
+            continue;
+        }
+
+        expansions.store(current, expand(currentValue, [this](std::string_view name)
+        {
+            const auto dependency = slotOf(std::string{name});
+            const auto *const expansion = expansions.find(dependency);
+            return expansion != nullptr ? std::optional<std::string_view>{*expansion} : rawValue(dependency);
+        }));
+    }
+    return *expansions.find(slot);
+}
+
+template<typename ValueOf>
+std::string ArgParser::expand(std::string_view value, ValueOf &&valueOf)
+{
+    std::string expansion{};
+    scanReferences(value, [&expansion](std::string_view text) { expansion.append(text); },
+                   [&expansion, &valueOf](std::string_view name)
+                   {
+                       if (name.substr(0, envPrefix.size()) == envPrefix)
+                       {
+                           if (const char *env = std::getenv(std::string{name.substr(envPrefix.size())}.c_str()))
+                           {
+                               expansion.append(env);
+                           }
+                       }
+                       else if (const auto referenced = valueOf(name))
+                       {
+                           expansion.append(*referenced);
+                       }
+                   });
+    return expansion;
+}
+
+inline
+void ArgParser::expandReferences() const
+{
+    for (std::size_t slot = 0; slot < configuredArgs.size(); ++slot)
+    {
+        if (expansions.hasReferences(slot))
+        {
+            parsedValue(slot);
+        }
+    }
+}
+
+inline
+ArgParser &ArgParser::setListDelimiter(char delimiter) noexcept
+{
+    listDelimiter = delimiter;
+    return *this;
+}
+
+inline
+ArgParser &ArgParser::addMutuallyExclusive(const std::vector<std::string> &args)
+{
+    return addConstraint(Constraint::Kind::AtMostOne, args);
+}
+
+inline
+ArgParser &ArgParser::addAtLeastOne(const std::vector<std::string> &args)
+{
+    return addConstraint(Constraint::Kind::AtLeastOne, args);
+}
+
+inline
+ArgParser &ArgParser::addRequires(const std::string &arg, const std::string &required)
+{
+    return addConstraint(Constraint::Kind::AllOf, {required}, configuredSlotOf(arg));
+}
+
+inline
+ArgParser &ArgParser::addConstraint(Constraint::Kind kind, const std::vector<std::string> &args, std::size_t trigger)
+{
+    Constraint constraint{kind, trigger};
+    for (const auto &arg : args)
+    {
+        constraint.add(configuredSlotOf(arg));
+    }
+    constraints.emplace_back(std::move(constraint));
+    return *this;
+}
+
+inline
+std::size_t ArgParser::configuredSlotOf(const std::string &arg) const
+{
+    const auto slot = slotOf(arg);
+    if (slot == npos)
+    {
+        throw std::runtime_error{concatenate("Unknown argument: ", arg)};
+    }
+    return slot;
+}
+
+inline
+void ArgParser::parse(int argc, char *argv[])
+{
+    parsedPool.clear();
+    parsedArgs.assign(configuredArgs.size(), StringRef{notParsed, 0});
+    // only the passed values are stored, others are resolved when retrieved
+    auto store = [this](std::size_t slot, std::string_view value)
+    {
+        parsedArgs[slot] = StringRef{static_cast<std::uint32_t>(parsedPool.size()),
+                                     static_cast<std::uint32_t>(value.size())};
+        parsedPool.append(value);
+    };
+    if (expansions.enabled)
+    {
+        expansions.reset(0); // expansions of the earlier values
+    }
+    parsePassed(argc, argv, store);
+    if (!needHelp() && !needCompletion())
+    {
+        if (expansions.enabled)
+        {
+            try
+            {
+                checkInterpolation();
+            }
+            catch (...)
+            {
+                // values which reference each other must not be retrieved, so none of them can be
+                parsedPool.clear();
+                parsedArgs.clear();
+                throw;
+            }
+        }
+        writeBindings();
+    }
+}
+
+template<typename Visitor>
+void ArgParser::parse(int argc, char *argv[], Visitor &&visitor)
+{
+    // nothing can be retrieved after this, not even the values of an earlier parse
+    parsedPool.clear();
+    parsedArgs.clear();
+    const auto passed = parsePassed(argc, argv, visitor);
+    if (!passed)
+    {
+        return;
+    }
+
+    // now visit those arguments which have overrides or default values, but were not passed
+    for (std::size_t slot = 0; slot < configuredArgs.size(); ++slot)
+    {
+        if (!passed->test(slot))
+        {
+            if (const auto value = fallbackValue(slot))
+            {
+                visitor(slot, *value);
+            }
+        }
+    }
+}
+
+template<typename Visitor>
+std::optional<ArgParser::SlotSet> ArgParser::parsePassed(int argc, char *argv[], Visitor &visitor)
+{
+    if (argc < 1 || argv == nullptr)
+    {
+        throw std::runtime_error{"Invalid command line arguments"};
+    }
+
+    appPath = argv[0];
+    isOnlyHelpString = false;
+    completionPrefix.reset();
+    if (argc == 2 && isHelpString(argv[1]))
+    {
+        isOnlyHelpString = true;
+        return std::nullopt;
+    }
+
+    if (argc == 3 && isCompletionString(argv[1]))
+    {
+        completionPrefix = argv[2];
+        return std::nullopt;
+    }
+
+    SlotSet passed{configuredArgs.size()};
+    for (int i = 1; i < argc; ++i)
+    {
+        const auto argValPair = argValueParser(argv[i]);
+        const auto slot = findSlot(argValPair.first);
+        if (slot == npos)
+        {
+            throw std::runtime_error(concatenate("Unknown argument: ", argValPair.first.parsedArg));
+        }
+        if (passed.test(slot))
+        {
+            throw std::runtime_error{concatenate("Received multiple values for: ", configuredArgs.toString(slot))};
+        }
+        passed.set(slot);
+        if (const auto mapped = resolveChoice(slot, argValPair.second))
+        {
+            parsedChoices[choicesIndex[slot]] = *mapped;
+        }
+        visitor(slot, argValPair.second);
+    }
+
+    checkConstraints(passed);
+    return passed;
+}
+
+template<typename Handler>
+void ArgParser::parse(std::istream &input, Handler &&handler, char delimiter) const
+{
+    // an item is handed over straight from the buffer, unless it spans two reads
+    // in that case it is assembled in @pending, so memory is bounded by the longest item
+    std::array<char, 4096> buffer{};
+    std::string pending{};
+
+    while (input)
+    {
+        input.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        const auto readCount = static_cast<std::size_t>(input.gcount());
+        std::string_view chunk{buffer.data(), readCount};
+
+        for (auto pos = chunk.find(delimiter); pos != std::string_view::npos; pos = chunk.find(delimiter))
+        {
+            if (pending.empty())
+            {
+                streamItem(chunk.substr(0, pos), handler);
+            }
+            else
+            {
+                pending.append(chunk.data(), pos);
+                streamItem(pending, handler);
+                pending.clear();
+            }
+            chunk.remove_prefix(pos + 1);
+        }
+        pending.append(chunk.data(), chunk.size());
+    }
+
+    if (input.bad())
+    {
+        throw std::runtime_error{"Failed to read arguments from input stream"};
+    }
+    streamItem(pending, handler); // the last item might not be followed by a delimiter
+}
+
+template<typename Handler>
+void ArgParser::streamItem(std::string_view item, Handler &handler) const
+{
+    if (item.empty())
+    {
+        return;
+    }
+
+    if (item.front() != '-')
+    {
+        handler(npos, item);
+        return;
+    }
+
+    const auto argValPair = argValueParser(item);
+    const auto slot = findSlot(argValPair.first);
+    if (slot == npos)
+    {
+        throw std::runtime_error(concatenate("Unknown argument: ", argValPair.first.parsedArg));
+    }
+    resolveChoice(slot, argValPair.second);
+    handler(slot, argValPair.second);
+}
+
+inline
+std::pair<ArgParser::ParsedArg, std::string_view> ArgParser::argValueParser(std::string_view arg)
+{
+    static constexpr char SEP{'='};
+    auto pos = arg.find(SEP);
+    if (pos == 0 || pos == std::string_view::npos)
+    {
+        throw std::runtime_error(concatenate("Separator [", SEP, "] is supposed to separate arg and value in: ", arg));
+    }
+
+    auto parsedArg{ParsedArg::parse_arg(arg.substr(0, pos))};
+    return std::make_pair(std::move(parsedArg), arg.substr(pos + 1));
+}
+
+inline
+std::size_t ArgParser::findSlot(const ParsedArg &arg) const noexcept
+{
+    if (arg.argType == ArgTypeEnum::Invalid)
+    {
+        return npos;
+    }
+    return configuredArgs.find(arg.parsedArg, arg.argType);
+}
+
+inline
+std::size_t ArgParser::slotOf(const std::string &arg) const noexcept
+{
+    return configuredArgs.find(arg);
+}
+
+inline
+std::optional<std::string_view> ArgParser::parsedValue(std::size_t slot) const
+{
+    if (expansions.hasReferences(slot))
+    {
+        if (const auto value = rawValue(slot))
+        {
+            return interpolatedValue(slot, *value);
+        }
+    }
+    return rawValue(slot);
+}
+
+inline
+std::optional<std::string_view> ArgParser::rawValue(std::size_t slot) const noexcept
+{
+    if (parsedArgs.empty())
+    {
+        return std::nullopt; // values are not kept, when parsed with a visitor
+    }
+    if (!isPassed(slot))
+    {
+        return fallbackValue(slot);
+    }
+    return std::string_view{parsedPool}.substr(parsedArgs[slot].offset, parsedArgs[slot].size);
+}
+
+inline
+bool ArgParser::isPassed(std::size_t slot) const noexcept
+{
+    return slot < parsedArgs.size() && parsedArgs[slot].offset != notParsed;
+}
+
+inline
+std::optional<std::string_view> ArgParser::fallbackValue(std::size_t slot) const noexcept
+{
+    if (!overrides.empty())
+    {
+        const auto it = std::lower_bound(overrides.cbegin(), overrides.cend(), slot, [](const auto &override, auto key)
+        {
+            return override.first < key;
+        });
+        if (it != overrides.cend() && it->first == slot)
+        {
+            return it->second;
+        }
+    }
+    if (slot < configuredArgs.size() && configuredArgs.hasDefaultValue(slot))
+    {
+        return configuredArgs.defaultValue(slot);
+    }
+    return std::nullopt;
+}
+
+template<typename T>
+std::optional<T> ArgParser::retrieve(const std::string &arg) const
+{
+    return retrieveSlot<T>(slotOf(arg));
+}
+
+template<typename T>
+std::optional<T> ArgParser::retrieve(Opt<T> opt) const
+{
+    if (opt.slot() >= configuredArgs.size())
+    {
+        return std::nullopt;
+    }
+    return retrieveSlot<T>(opt.slot());
+}
+
+template<typename T>
+T ArgParser::retrieveMayThrow(Opt<T> opt) const
+{
+    if (opt.slot() >= configuredArgs.size())
+    {
+        throw std::runtime_error{concatenate("Unknown argument handle of slot ", opt.slot())};
+    }
+    const auto retrieved_opt = retrieve(opt);
+    if (retrieved_opt)
+    {
+        return *retrieved_opt;
+    }
+    throw std::runtime_error{concatenate("Type conversion failed for ", configuredArgs.longOpt(opt.slot()))};
+}
+
+template<typename T>
+std::optional<T> ArgParser::retrieveSlot(std::size_t slot) const
+{
+    validateRetrieval();
+    const auto value = parsedValue(slot); // std::nullopt for npos as well
+    if (!value)
+    {
+        return std::nullopt;
+    }
+    return convertSlot<T>(slot, *value, isPassed(slot));
+}
+
+template<typename T>
+std::optional<T> ArgParser::convertSlot(std::size_t slot, std::string_view value, bool isResolved) const
+{
+    if constexpr(IsList<T>::value)
+    {
+        return from_list<typename T::value_type>(value, listDelimiter);
+    }
+
+    if constexpr(isChoiceType<T>)
+    {
+        const auto index = choicesOf(slot);
+        if (index != npos)
+        {
+            // passed values are resolved by parse(), the others were checked when these were set
+            return static_cast<T>(isResolved ? parsedChoices[index] : *argChoices[index].find(value));
+        }
+    }
+    return from_string<T>(value);
+}
+
+template<typename T>
+std::optional<std::vector<T>> ArgParser::from_list(std::string_view list, char delimiter)
+{
+    static_assert(!IsList<T>::value, "only one level of list is supported");
+
+    std::vector<T> elements{};
+    if (list.empty())
+    {
+        return elements;
+    }
+
+    elements.reserve(countOf(list, delimiter) + 1);
+    const auto *begin = list.data();
+    const auto *const end = list.data() + list.size();
+    while (true)
+    {
+        const char *elementEnd{nullptr};
+        if constexpr(std::is_arithmetic_v<T> && !std::is_same_v<T, bool> && !std::is_same_v<T, char>)
+        {
+            // a number ends at the delimiter, so it is converted without looking for the delimiter first
+            T element{};
+            const auto [ptr, ec] = fromChars(begin, end, element);
+            if (ec != std::errc{} || (ptr != end && *ptr != delimiter))
+            {
+                return std::nullopt;
+            }
+            elements.push_back(element);
+            elementEnd = ptr;
+        }
+        else
+        {
+            // memchr is vectorized by the C library
+            const auto *const found = static_cast<const char *>(std::memchr(begin, delimiter,
+                                                                              static_cast<std::size_t>(end - begin)));
+            elementEnd = found != nullptr ? found : end;
+            auto element = from_string<T>(std::string_view{begin, static_cast<std::size_t>(elementEnd - begin)});
+            if (!element)
+            {
+                return std::nullopt;
+            }
+            elements.push_back(std::move(*element));
+        }
+
+        if (elementEnd == end || elementEnd + 1 == end) // a trailing delimiter doesn't start another element
+        {
+            return elements;
+        }
+        begin = elementEnd + 1;
+    }
+}
+
+inline
+std::size_t ArgParser::countOf(std::string_view str, char c) noexcept
+{
+    static constexpr std::uint64_t lowBits{0x7F7F7F7F7F7F7F7Full};
+    static constexpr std::uint64_t byteLanes{0x00FF00FF00FF00FFull};
+    const auto pattern = 0x0101010101010101ull * static_cast<unsigned char>(c);
+
+    std::size_t count{0};
+    std::size_t pos{0};
+    while (pos + 8 <= str.size())
+    {
+        // each byte of @matches counts the matches in that lane, so at most 255 words are added before these are
+        // summed up
+        std::uint64_t matches{0};
+        for (int word = 0; word < 255 && pos + 8 <= str.size(); ++word, pos += 8)
+        {
+            std::uint64_t bytes{0};
+            std::memcpy(&bytes, str.data() + pos, sizeof(bytes));
+            bytes ^= pattern;
+            // high bit of a byte is set only if that byte is 0, i.e. it was @c
+            matches += ~(((bytes & lowBits) + lowBits) | bytes | lowBits) >> 7u;
+        }
+        matches = (matches & byteLanes) + (matches >> 8u & byteLanes);
+        count += static_cast<std::size_t>((matches * 0x0001000100010001ull) >> 48u);
+    }
+    for (; pos < str.size(); ++pos)
+    {
+        count += str[pos] == c;
+    }
+    return count;
+}
+
+template<typename T>
+inline
+std::from_chars_result ArgParser::fromChars(const char *first, const char *last, T &value) noexcept
+{
+    if constexpr(std::is_floating_point_v<T> && !hasFloatFromChars)
+    {
+        if constexpr(std::is_same_v<T, long double>)
+        {
+            double result{};
+            const auto converted = FloatParser::parse(first, last, result);
+            if (converted.ec == std::errc{})
+            {
+                value = result;
+            }
+            return converted;
+        }
+        else
+        {
+            return FloatParser::parse(first, last, value);
+        }
+    }
+    else if constexpr(std::is_integral_v<T>)
+    {
+        // 0x and 0b prefixes, after the sign
+        const bool negative = first != last && *first == '-';
+        const auto *const digits = first + negative;
+        if (last - digits < 3 || digits[0] != '0' || ((digits[1] | 0x20) != 'x' && (digits[1] | 0x20) != 'b')
+            || digits[2] == '-')
+        {
+            return std::from_chars(first, last, value);
+        }
+
+        const auto base = (digits[1] | 0x20) == 'x' ? 16 : 2;
+        std::make_unsigned_t<T> magnitude{};
+        auto result = std::from_chars(digits + 2, last, magnitude, base);
+        if (result.ec == std::errc::invalid_argument || (negative && !std::is_signed_v<T>))
+        {
+            return {first, std::errc::invalid_argument};
+        }
+        const auto limit = static_cast<std::make_unsigned_t<T>>(std::numeric_limits<T>::max()) + negative;
+        if (result.ec == std::errc{} && magnitude > limit)
+        {
+            result.ec = std::errc::result_out_of_range;
+        }
+        if (result.ec == std::errc{})
+        {
+            // -max - 1 can't be negated from max + 1 in T
+            value = !negative || magnitude == 0 ? static_cast<T>(magnitude)
+                                                : static_cast<T>(-static_cast<T>(magnitude - 1) - 1);
+        }
+        return result;
+    }
+    else
+    {
+        return std::from_chars(first, last, value);
+    }
+}
+
+inline
+bool ArgParser::ByteSize::operator==(const ByteSize &other) const noexcept
+{
+    return bytes == other.bytes;
+}
+
+inline
+bool ArgParser::Count::operator==(const Count &other) const noexcept
+{
+    return value == other.value;
+}
+
+inline
+bool ArgParser::Rate::operator==(const Rate &other) const noexcept
+{
+    return perSecond == other.perSecond;
+}
+
+inline
+std::optional<ArgParser::Fixed> ArgParser::readFixed(std::string_view &text) noexcept
+{
+    static constexpr auto max = std::numeric_limits<std::uint64_t>::max();
+    const auto *const end = text.data() + text.size();
+    Fixed number{0, 1};
+    auto [ptr, ec] = std::from_chars(text.data(), end, number.mantissa);
+    if (ec != std::errc{})
+    {
+        return std::nullopt;
+    }
+    if (ptr != end && *ptr == '.')
+    {
+        const auto *const fraction = ptr + 1;
+        std::uint64_t digits{0};
+        const auto [fractionEnd, fractionEc] = std::from_chars(fraction, end, digits);
+        if (fractionEc != std::errc{})
+        {
+            return std::nullopt;
+        }
+        for (auto count = fractionEnd - fraction; count > 0; --count)
+        {
+            if (number.mantissa > max / 10 || number.scale > max / 10)
+            {
+                return std::nullopt;
+            }
+            number.mantissa *= 10;
+            number.scale *= 10;
+        }
+        if (number.mantissa > max - digits)
+        {
+            return std::nullopt;
+        }
+        number.mantissa += digits;
+        ptr = fractionEnd;
+    }
+    text.remove_prefix(static_cast<std::size_t>(ptr - text.data()));
+    return number;
+}
+
+template<std::size_t N>
+inline
+const ArgParser::Unit *ArgParser::findUnit(std::string_view name, const Unit (&units)[N]) noexcept
+{
+    const auto unit = std::find_if(std::begin(units), std::end(units), [name](const Unit &unit)
+    {
+        return unit.name == name;
+    });
+    return unit == std::end(units) ? nullptr : unit;
+}
+
+inline
+std::optional<std::uint64_t> ArgParser::scaleExactly(Fixed number, std::uint64_t num, std::uint64_t den) noexcept
+{
+    // once numerators and denominators have no common factors, it is a whole number only if denominators are 1
+    for (auto *numerator : {&number.mantissa, &num})
+    {
+        for (auto *denominator : {&number.scale, &den})
+        {
+            const auto divisor = std::gcd(*numerator, *denominator);
+            *numerator /= divisor;
+            *denominator /= divisor;
+        }
+    }
+    if (number.scale != 1 || den != 1
+        || (num != 0 && number.mantissa > std::numeric_limits<std::uint64_t>::max() / num))
+    {
+        return std::nullopt;
+    }
+    return number.mantissa * num;
+}
+
+template<std::size_t N>
+inline
+std::optional<std::uint64_t> ArgParser::from_quantity(std::string_view arg, const Unit (&units)[N]) noexcept
+{
+    const auto number = readFixed(arg);
+    const auto *const unit = arg.empty() ? &units[0] : findUnit(arg, units);
+    if (!number || unit == nullptr)
+    {
+        return std::nullopt;
+    }
+    return scaleExactly(*number, unit->num, unit->den);
+}
+
+template<typename T>
+inline
+std::optional<T> ArgParser::from_duration(std::string_view arg) noexcept
+{
+    using Rep = typename T::rep;
+    using Period = typename T::period;
+    const bool negative = std::is_signed_v<Rep> && !arg.empty() && arg.front() == '-';
+    arg.remove_prefix(negative);
+    const auto number = readFixed(arg);
+    if (!number)
+    {
+        return std::nullopt;
+    }
+
+    // a unit is unit.num * Period::den / (unit.den * Period::num) of Period, no unit is one Period
+    std::uint64_t num{1}, den{1};
+    if (!arg.empty())
+    {
+        const auto *const unit = findUnit(arg, timeUnits);
+        if (unit == nullptr)
+        {
+            return std::nullopt;
+        }
+        const auto numDivisor = std::gcd(unit->num, static_cast<std::uint64_t>(Period::num));
+        const auto denDivisor = std::gcd(unit->den, static_cast<std::uint64_t>(Period::den));
+        const auto periodDen = static_cast<std::uint64_t>(Period::den) / denDivisor;
+        const auto periodNum = static_cast<std::uint64_t>(Period::num) / numDivisor;
+        num = unit->num / numDivisor;
+        den = unit->den / denDivisor;
+        if (num > std::numeric_limits<std::uint64_t>::max() / periodDen
+            || den > std::numeric_limits<std::uint64_t>::max() / periodNum)
+        {
+            return std::nullopt;
+        }
+        num *= periodDen;
+        den *= periodNum;
+    }
+
+    if constexpr(std::is_floating_point_v<Rep>)
+    {
+        const auto count = static_cast<Rep>(number->mantissa) / static_cast<Rep>(number->scale)
+                           * static_cast<Rep>(num) / static_cast<Rep>(den);
+        return T{negative ? -count : count};
+    }
+    else
+    {
+        const auto count = scaleExactly(*number, num, den);
+        if (!count || *count > static_cast<std::make_unsigned_t<Rep>>(std::numeric_limits<Rep>::max()))
+        {
+            return std::nullopt;
+        }
+        return T{negative ? static_cast<Rep>(-static_cast<Rep>(*count)) : static_cast<Rep>(*count)};
+    }
+}
+
+inline
+std::optional<ArgParser::Rate> ArgParser::from_rate(std::string_view arg) noexcept
+{
+    const auto slash = arg.find('/');
+    const auto per = slash == std::string_view::npos ? std::string_view{"s"} : arg.substr(slash + 1);
+    arg = arg.substr(0, slash);
+
+    double number{};
+    const auto [ptr, ec] = fromChars(arg.data(), arg.data() + arg.size(), number);
+    const auto *const unit = findUnit(arg.substr(static_cast<std::size_t>(ptr - arg.data())), countUnits);
+    const auto *const timeUnit = findUnit(per, timeUnits);
+    if (ec != std::errc{} || !std::isfinite(number) || number < 0 || unit == nullptr || timeUnit == nullptr)
+    {
+        return std::nullopt;
+    }
+    return Rate{number * static_cast<double>(unit->num) * static_cast<double>(timeUnit->den)
+                / static_cast<double>(timeUnit->num)};
+}
+
+template<std::size_t N>
+inline
+std::string ArgParser::quantity_to_string(std::uint64_t value, const Unit (&units)[N]) noexcept
+{
+    const auto *unit = &units[0];
+    for (const auto &candidate : units)
+    {
+        if (value != 0 && candidate.den == 1 && value % candidate.num == 0 && candidate.num > unit->num)
+        {
+            unit = &candidate;
+        }
+    }
+    return std::to_string(value / unit->num).append(unit->name);
+}
+
+template<typename T>
+inline
+std::optional<T> ArgParser::from_string(std::string_view arg) noexcept
+{
+    if constexpr(std::is_same_v<T, std::string>)
+    {
+        return std::string{arg};
+    }
+    else if constexpr(std::is_same_v<T, bool>)
+    {
+        if (arg == truthy) return true;
+        if (arg == falsy)  return false;
+        return std::nullopt;
+    }
+    else if constexpr(std::is_same_v<T, char>)
+    {
+        return (arg.size() == 1) ? std::optional<char>(arg[0]) : std::nullopt;
+    }
+    else if constexpr(IsDuration<T>::value)
+    {
+        return from_duration<T>(arg);
+    }
+    else if constexpr(std::is_same_v<T, ByteSize>)
+    {
+        const auto bytes = from_quantity(arg, byteUnits);
+        return bytes ? std::optional<T>{T{*bytes}} : std::nullopt;
+    }
+    else if constexpr(std::is_same_v<T, Count>)
+    {
+        const auto count = from_quantity(arg, countUnits);
+        return count ? std::optional<T>{T{*count}} : std::nullopt;
+    }
+    else if constexpr(std::is_same_v<T, Rate>)
+    {
+        return from_rate(arg);
+    }
+    else if constexpr(std::is_arithmetic_v<std::remove_pointer_t<std::remove_reference_t<T>>>)
+    {
+        T result{};
+        auto end_ptr = arg.data() + arg.size();
+        auto[ptr, ec] = fromChars(arg.data(), end_ptr, result);
+        if (ptr == end_ptr && ec == std::errc{})
+        {
+            return result;
+        }
+    }
+
+    return std::nullopt;
+}
+
+inline
+std::string ArgParser::helpMsg() const noexcept
+{
+    std::ostringstream os{};
+
+    if (!getDescription().empty())
+    {
+        os << getDescription() << "\n";
+    }
+
+    os << "Following is a list of configured arguments:\n";
+
+    for (std::size_t slot = 0; slot < configuredArgs.size(); ++slot)
+    {
+        os << configuredArgs.toVerboseString(slot);
+        if (choicesOf(slot) != npos)
+        {
+            os << ", allowed: " << argChoices[choicesOf(slot)].allowed();
+        }
+        os << "\n";
+    }
+    return os.str();
+}
+
+inline
+bool ArgParser::isHelpString(const std::string &arg) noexcept
+{
+    static constexpr auto ShortHelpString{"-h"};
+    static constexpr auto LongHelpString{"--help"};
+
+    return arg == ShortHelpString || arg == LongHelpString;
+}
+
+inline
+bool ArgParser::needHelp() const noexcept
+{
+    return isOnlyHelpString;
+}
+
+inline
+bool ArgParser::isCompletionString(const std::string &arg) noexcept
+{
+    static constexpr auto CompletionString{"--complete"};
+    return arg == CompletionString;
+}
+
+inline
+bool ArgParser::needCompletion() const noexcept
+{
+    return completionPrefix.has_value();
+}
+
+inline
+std::vector<std::string> ArgParser::completionWords(std::string_view prefix) const
+{
+    // a single linear pass over the names to filter, then only the matches are sorted
+    // building a sorted index would cost more than this one lookup, as the process answers only once
+    std::vector<std::string> words{};
+    std::string word{};
+    const auto addIfMatches = [&prefix, &words, &word](std::string_view dashes, std::string_view name,
+                                                        bool takesValue)
+    {
+        word.assign(dashes).append(name);
+        if (takesValue)
+        {
+            word.push_back('=');
+        }
+        if (word.compare(0, prefix.size(), prefix) == 0)
+        {
+            words.push_back(word);
+        }
+    };
+
+    for (std::size_t slot = 0; slot < configuredArgs.size(); ++slot)
+    {
+        const bool takesValue = slot != 0; // the first one is always help
+        addIfMatches("-", configuredArgs.shortOpt(slot), takesValue);
+        addIfMatches("--", configuredArgs.longOpt(slot), takesValue);
+    }
+    std::sort(words.begin(), words.end());
+    return words;
+}
+
+inline
+std::string ArgParser::completionMsg() const
+{
+    if (!needCompletion())
+    {
+        throw std::runtime_error{"Application was not run with '--complete'"};
+    }
+
+    std::string msg{};
+    for (const auto &word : completionWords(*completionPrefix))
+    {
+        msg.append(word).push_back('\n');
+    }
+    return msg;
+}
+
+inline
+std::string ArgParser::completionScript(Shell shell, const std::string &appName) const
+{
+    const auto isNameChar = [](unsigned char c) { return std::isalnum(c) || c == '_' || c == '.' || c == '-'; };
+    if (appName.empty() || !std::all_of(appName.begin(), appName.end(), isNameChar))
+    {
+        throw std::runtime_error{concatenate("Invalid application name [", appName, "] for completion, it must ",
+                                             "only consist of alphanumeric characters, '_', '.' and '-'")};
+    }
+
+    // shell function names can't have all the characters of a file name
+    std::string functionName{concatenate('_', appName, "_complete")};
+    std::replace_if(functionName.begin(), functionName.end(), [](unsigned char c) { return !std::isalnum(c); }, '_');
+
+    std::string words{};
+    for (const auto &word : completionWords(""))
+    {
+        words.append(words.empty() ? "" : " ").append(word);
+    }
+
+    std::ostringstream os{};
+    switch (shell)
+    {
+        case Shell::Bash:
+            os << "# bash completion for " << appName << "\n"
+               << functionName << "()\n{\n"
+               << "    COMPREPLY=($(compgen -W \"" << words << "\" -- \"${COMP_WORDS[COMP_CWORD]}\"))\n}\n"
+               << "complete -o nospace -F " << functionName << " " << appName << "\n";
+            break;
+
+        case Shell::Zsh:
+            os << "#compdef " << appName << "\n"
+               << functionName << "()\n{\n"
+               << "    compadd -S '' -- " << words << "\n}\n"
+               << "compdef " << functionName << " " << appName << "\n";
+            break;
+
+        case Shell::Fish:
+            os << "# fish completion for " << appName << "\n"
+               << "complete -c " << appName << " -f -a '" << words << "'\n";
+            break;
+    }
+    return os.str();
+}
+
+inline
+ArgParser::ArgParser(std::string description) : description(std::move(description))
+{
+    init();
+}
+
+inline
+const std::string &ArgParser::getDescription() const noexcept
+{
+    return description;
+}
+
+template<typename T>
+T ArgParser::retrieveMayThrow(const std::string &arg) const
+{
+    const auto retrieved_opt = retrieve<T>(arg);
+    if (retrieved_opt)
+    {
+        return *retrieved_opt;
+    }
+    throw std::runtime_error{concatenate("Type conversion failed for ", arg)};
+}
+
+inline
+bool ArgParser::contains(const std::string &arg) const noexcept
+{
+    return rawValue(slotOf(arg)).has_value(); // a value has an expansion, if it has references
+}
+
+inline
+bool ArgParser::Fingerprint::operator==(const Fingerprint &other) const noexcept
+{
+    return low == other.low && high == other.high;
+}
+
+inline
+bool ArgParser::Fingerprint::operator!=(const Fingerprint &other) const noexcept
+{
+    return !(*this == other);
+}
+
+inline
+std::string ArgParser::Fingerprint::toHex() const
+{
+    static constexpr std::string_view digits{"0123456789abcdef"};
+    std::string hex(32, '0');
+    for (std::size_t i = 0; i < 16; ++i)
+    {
+        hex[15 - i] = digits[(high >> (4 * i)) & 0xFu];
+        hex[31 - i] = digits[(low >> (4 * i)) & 0xFu];
+    }
+    return hex;
+}
+
+inline
+ArgParser::Fingerprint ArgParser::fingerprint() const
+{
+    validateRetrieval();
+    // the two halves are hashed with different seeds, a long option seeds the hash of its value
+    static constexpr std::uint64_t highSeed{0x6A09E667F3BCC909ull};
+    Fingerprint fingerprint{};
+    // slot 0 is the default help argument
+    for (std::size_t slot = 1; slot < configuredArgs.size(); ++slot)
+    {
+        const auto value = parsedValue(slot);
+        if (value && configuredArgs.affectsOutput(slot))
+        {
+            const auto longOpt = configuredArgs.longOpt(slot);
+            fingerprint.low += hashString(*value, hashString(longOpt) + value->size());
+            fingerprint.high += hashString(*value, hashString(longOpt, highSeed) + value->size());
+        }
+    }
+    return fingerprint;
+}
+
+inline
+std::string ArgParser::canonicalConfig() const
+{
+    validateRetrieval();
+    std::vector<std::pair<std::string_view, std::string_view>> values{};
+    values.reserve(configuredArgs.size());
+    for (std::size_t slot = 1; slot < configuredArgs.size(); ++slot)
+    {
+        const auto value = parsedValue(slot);
+        if (value && configuredArgs.affectsOutput(slot))
+        {
+            values.emplace_back(configuredArgs.longOpt(slot), *value);
+        }
+    }
+    std::sort(values.begin(), values.end());
+
+    std::string config{};
+    for (const auto &[longOpt, value] : values)
+    {
+        config.append(longOpt).append(1, '=');
+        for (const char c : value)
+        {
+            config.append(c == '\\' ? "\\\\" : c == '\n' ? "\\n" : std::string_view{&c, 1});
+        }
+        config.append(1, '\n');
+    }
+    return config;
+}
+
+inline
+std::string ArgParser::snapshot() const
+{
+    validateRetrieval();
+
+    const auto appendU32 = [](std::string &blob, std::size_t value)
+    {
+        for (int shift = 0; shift < 32; shift += 8)
+        {
+            blob.push_back(static_cast<char>((value >> shift) & 0xFFu));
+        }
+    };
+
+    std::size_t entryCount{0};
+    std::size_t stringsSize{appPath.size()};
+    for (std::size_t slot = 0; slot < configuredArgs.size(); ++slot)
+    {
+        if (const auto value = parsedValue(slot))
+        {
+            ++entryCount;
+            stringsSize += configuredArgs.shortOpt(slot).size() + configuredArgs.longOpt(slot).size() + value->size();
+        }
+    }
+
+    // every offset and size is within the blob, so they all fit in 32 bit if its size does
+    const auto tableEnd = snapshotHeaderSize + entryCount * snapshotEntrySize;
+    if (tableEnd + stringsSize > std::numeric_limits<std::uint32_t>::max())
+    {
+        throw std::length_error{concatenate("Snapshot of parsed arguments is too large: ", tableEnd + stringsSize,
+                                            " bytes")};
+    }
+
+    std::string blob{};
+    blob.reserve(tableEnd + stringsSize);
+    blob.append(snapshotMagic);
+    appendU32(blob, snapshotVersion);
+    appendU32(blob, tableEnd);
+    appendU32(blob, appPath.size());
+    appendU32(blob, entryCount);
+    appendU32(blob, static_cast<unsigned char>(listDelimiter));
+
+    auto offset = tableEnd + appPath.size();
+    for (std::size_t slot = 0; slot < configuredArgs.size(); ++slot)
+    {
+        if (const auto value = parsedValue(slot))
+        {
+            for (const auto str : {configuredArgs.shortOpt(slot), configuredArgs.longOpt(slot), *value})
+            {
+                appendU32(blob, offset);
+                appendU32(blob, str.size());
+                offset += str.size();
+            }
+
+            // choices are resolved here, as the reader doesn't know them
+            const auto mapped = choicesOf(slot) != npos ? convertSlot<std::int64_t>(slot, *value, isPassed(slot))
+                                                        : std::nullopt;
+            const auto bits = static_cast<std::uint64_t>(mapped.value_or(0));
+            appendU32(blob, mapped.has_value());
+            appendU32(blob, bits & 0xFFFFFFFFu);
+            appendU32(blob, bits >> 32u);
+        }
+    }
+
+    blob.append(appPath);
+    for (std::size_t slot = 0; slot < configuredArgs.size(); ++slot)
+    {
+        if (const auto value = parsedValue(slot))
+        {
+            blob.append(configuredArgs.shortOpt(slot)).append(configuredArgs.longOpt(slot)).append(*value);
+        }
+    }
+    return blob;
+}
+
+inline
+std::string ArgParser::schemaJson() const
+{
+    std::string json{concatenate("{\"description\": ", toJson(description),
+                                 expansions.enabled ? ", \"interpolation\": true" : "", ", \"arguments\": [")};
+    // slot 0 is the default help argument
+    for (std::size_t slot = 1; slot < configuredArgs.size(); ++slot)
+    {
+        json += concatenate(slot == 1 ? "\n  " : ",\n  ", "{\"short\": ", toJson(configuredArgs.shortOpt(slot)),
+                            ", \"long\": ", toJson(configuredArgs.longOpt(slot)),
+                            ", \"help\": ", toJson(configuredArgs.helpMsg(slot)));
+        if (configuredArgs.isMandatory(slot))
+        {
+            json += ", \"mandatory\": true";
+        }
+        if (configuredArgs.hasDefaultValue(slot))
+        {
+            json += concatenate(", \"default\": ", toJson(configuredArgs.defaultValue(slot)));
+        }
+        if (!configuredArgs.affectsOutput(slot))
+        {
+            json += ", \"affectsOutput\": false";
+        }
+        if (const auto index = choicesOf(slot); index != npos)
+        {
+            json += ", \"choices\": {";
+            for (const auto &[name, value] : argChoices[index].all())
+            {
+                json += concatenate(json.back() == '{' ? "" : ", ", toJson(name), ": ", value);
+            }
+            json += '}';
+        }
+        json += '}';
+    }
+
+    json += "], \"constraints\": [";
+    for (const auto &constraint : constraints)
+    {
+        json += &constraint == &constraints.front() ? "\n  " : ",\n  ";
+        switch (constraint.kind)
+        {
+            case Constraint::Kind::AtMostOne:
+                json += concatenate("{\"kind\": \"mutuallyExclusive\", \"arguments\": ", constraintJson(constraint),
+                                    '}');
+                break;
+            case Constraint::Kind::AtLeastOne:
+                json += concatenate("{\"kind\": \"atLeastOne\", \"arguments\": ", constraintJson(constraint), '}');
+                break;
+            case Constraint::Kind::AllOf:
+                // only @addRequires adds these, mandatory arguments are exported with the arguments
+                json += concatenate("{\"kind\": \"requires\", \"argument\": ",
+                                    toJson(configuredArgs.longOpt(constraint.trigger)), ", \"required\": ",
+                                    constraintJson(constraint), '}');
+                break;
+        }
+    }
+    return json + "]}\n";
+}
+
+inline
+ArgParser ArgParser::fromSchemaJson(std::string_view json)
+{
+    const auto schema = JsonReader{json}.read();
+    const auto *const description = schema.find("description");
+    const auto *const arguments = schema.find("arguments");
+    if (arguments == nullptr || arguments->type != JsonValue::Type::Array)
+    {
+        throw std::runtime_error{"Invalid schema: \"arguments\" must be an array"};
+    }
+
+    ArgParser argParser{description != nullptr ? description->text : std::string{}};
+    if (const auto *const interpolation = schema.find("interpolation"))
+    {
+        if (interpolation->type != JsonValue::Type::Bool)
+        {
+            throw std::runtime_error{"Invalid schema: \"interpolation\" must be a boolean"};
+        }
+        argParser.expansions.enabled = interpolation->boolean;
+    }
+    for (const auto &arg : arguments->items)
+    {
+        argParser.addJsonArgument(arg);
+        if (const auto *const affectsOutput = arg.find("affectsOutput"))
+        {
+            if (affectsOutput->type != JsonValue::Type::Bool)
+            {
+                throw std::runtime_error{"Invalid schema: \"affectsOutput\" of an argument must be a boolean"};
+            }
+            if (!affectsOutput->boolean)
+            {
+                argParser.configuredArgs.excludeFromOutput(argParser.configuredArgs.size() - 1);
+            }
+        }
+    }
+    if (const auto *const constraints = schema.find("constraints"))
+    {
+        for (const auto &constraint : constraints->items)
+        {
+            argParser.addJsonConstraint(constraint);
+        }
+    }
+    return argParser;
+}
+
+inline
+std::string ArgParser::constraintJson(const Constraint &constraint) const
+{
+    std::string json{"["};
+    for (std::size_t index = 0; index < constraint.mask.size(); ++index)
+    {
+        for (std::size_t bit = 0; bit < slotsPerWord; ++bit)
+        {
+            if ((constraint.mask[index] >> bit & 1u) != 0)
+            {
+                const auto slot = (constraint.firstWord + index) * slotsPerWord + bit;
+                json += concatenate(json.size() == 1 ? "" : ", ", toJson(configuredArgs.longOpt(slot)));
+            }
+        }
+    }
+    return json + ']';
+}
+
+inline
+void ArgParser::addJsonArgument(const JsonValue &arg)
+{
+    const auto stringOf = [&arg](std::string_view key) -> std::optional<std::string>
+    {
+        const auto *const value = arg.find(key);
+        if (value == nullptr)
+        {
+            return std::nullopt;
+        }
+        if (value->type != JsonValue::Type::String)
+        {
+            throw std::runtime_error{concatenate("Invalid schema: \"", key, "\" of an argument must be a string")};
+        }
+        return value->text;
+    };
+
+    const auto shortOpt = stringOf("short");
+    const auto longOpt = stringOf("long");
+    if (!shortOpt || !longOpt)
+    {
+        throw std::runtime_error{"Invalid schema: each argument must have \"short\" and \"long\""};
+    }
+    const auto helpMsg = stringOf("help").value_or("");
+    const auto defaultValue = stringOf("default");
+    const auto *const mandatory = arg.find("mandatory");
+    if (mandatory != nullptr && mandatory->type != JsonValue::Type::Bool)
+    {
+        throw std::runtime_error{"Invalid schema: \"mandatory\" of an argument must be a boolean"};
+    }
+    const bool isMandatory = mandatory != nullptr && mandatory->boolean;
+    if (isMandatory && defaultValue)
+    {
+        throw std::runtime_error{
+                concatenate("Invalid schema: [-", *shortOpt, ", --", *longOpt, "] is mandatory and has a default value")};
+    }
+
+    const auto *const choices = arg.find("choices");
+    if (choices == nullptr)
+    {
+        addArgumentImpl(specToArg(ArgSpec{'-' + *shortOpt, "--" + *longOpt, helpMsg, defaultValue, isMandatory}));
+        return;
+    }
+
+    std::vector<std::pair<std::string, std::int64_t>> mappedChoices{};
+    for (std::size_t i = 0; i < choices->items.size(); ++i)
+    {
+        const auto &text = choices->items[i].text;
+        std::int64_t value{0};
+        const auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+        if (choices->items[i].type != JsonValue::Type::Number || ec != std::errc{} || end != text.data() + text.size())
+        {
+            throw std::runtime_error{concatenate("Invalid schema: choice [", choices->keys[i], "] of [-", *shortOpt,
+                                                 ", --", *longOpt, "] must map to an integer")};
+        }
+        mappedChoices.emplace_back(choices->keys[i], value);
+    }
+    if (defaultValue)
+    {
+        addChoiceArgumentWithDefault('-' + *shortOpt, "--" + *longOpt, helpMsg, mappedChoices, *defaultValue);
+    }
+    else
+    {
+        addChoiceArgument('-' + *shortOpt, "--" + *longOpt, helpMsg, mappedChoices, isMandatory);
+    }
+}
+
+inline
+void ArgParser::addJsonConstraint(const JsonValue &constraint)
+{
+    const auto namesOf = [](const JsonValue *value)
+    {
+        std::vector<std::string> names{};
+        if (value != nullptr)
+        {
+            std::transform(value->items.cbegin(), value->items.cend(), std::back_inserter(names),
+                           [](const JsonValue &name) { return name.text; });
+        }
+        return names;
+    };
+
+    const auto *const kind = constraint.find("kind");
+    const auto kindName = kind != nullptr ? kind->text : std::string{};
+    if (kindName == "mutuallyExclusive")
+    {
+        addMutuallyExclusive(namesOf(constraint.find("arguments")));
+    }
+    else if (kindName == "atLeastOne")
+    {
+        addAtLeastOne(namesOf(constraint.find("arguments")));
+    }
+    else if (const auto *const arg = constraint.find("argument"); kindName == "requires" && arg != nullptr)
+    {
+        for (const auto &required : namesOf(constraint.find("required")))
+        {
+            addRequires(arg->text, required);
+        }
+    }
+    else
+    {
+        throw std::runtime_error{concatenate("Invalid schema: unknown constraint [", kindName, ']')};
+    }
+}
+
+inline
+std::string ArgParser::toJson(std::string_view str)
+{
+    static constexpr auto hexDigits = "0123456789abcdef";
+    std::string json{"\""};
+    json.reserve(str.size() + 2);
+    for (const char c : str)
+    {
+        switch (c)
+        {
+            case '"': json += "\\\""; break;
+            case '\\': json += "\\\\"; break;
+            case '\n': json += "\\n"; break;
+            case '\r': json += "\\r"; break;
+            case '\t': json += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20u)
+                {
+                    json.append("\\u00").append(1, hexDigits[c >> 4]).append(1, hexDigits[c & 0xF]);
+                }
+                else
+                {
+                    json += c;
+                }
+        }
+    }
+    return json + '"';
+}
+
+inline
+void ArgParser::init() noexcept
+{
+    // the default help argument
+    configuredArgs.add(Arg{"-h", "--help", "to get this message"});
+}
+
+inline
+ArgParser::ArgParser()
+{
+    init();
+}
+
+inline
+void ArgParser::validateRetrieval() const
+{
+    if (appPath.empty())
+    {
+        // this means parse() was never called
+        throw std::runtime_error{"parse() must be called with command line arguments before retrieving values"};
+    }
+
+    if (needHelp())
+    {
+        throw std::runtime_error{"Application was run with '-h' or '--help', retrieving values is not allowed. "
+                                 "Should call @helpMsg and return"};
+    }
+
+    if (needCompletion())
+    {
+        throw std::runtime_error{"Application was run with '--complete', retrieving values is not allowed. "
+                                 "Should call @completionMsg and return"};
+    }
+}
+
+inline
+void ArgParser::checkConstraints(const SlotSet &passed) const
+{
+    checkConstraint(mandatoryArgs, passed);
+    for (const auto &constraint : constraints)
+    {
+        checkConstraint(constraint, passed);
+    }
+}
+
+inline
+void ArgParser::checkConstraint(const Constraint &constraint, const SlotSet &passed) const
+{
+    if (constraint.trigger != npos && !passed.test(constraint.trigger))
+    {
+        return;
+    }
+
+    std::uint64_t anyPassed{0};
+    bool manyPassed{false};
+    for (std::size_t index = 0; index < constraint.mask.size(); ++index)
+    {
+        const auto mask = constraint.mask[index];
+        const auto passedInMask = passed.word(constraint.firstWord + index) & mask;
+        if (constraint.kind == Constraint::Kind::AllOf && passedInMask != mask)
+        {
+            // only the first missing one is reported
+            const auto missing = mask & ~passedInMask;
+            auto slot = (constraint.firstWord + index) * slotsPerWord;
+            for (auto bit = missing; (bit & 1u) == 0; bit >>= 1u)
+            {
+                ++slot;
+            }
+            if (constraint.trigger == npos)
+            {
+                throw std::runtime_error{concatenate("Couldn't find [", configuredArgs.toString(slot),
+                                                     "] mandatory argument in passed arguments")};
+            }
+            throw std::runtime_error{concatenate("[", configuredArgs.toString(constraint.trigger), "] requires [",
+                                                 configuredArgs.toString(slot), "] to be passed as well")};
+        }
+        manyPassed = manyPassed || (anyPassed != 0 && passedInMask != 0) || (passedInMask & (passedInMask - 1)) != 0;
+        anyPassed |= passedInMask;
+    }
+
+    if (constraint.kind == Constraint::Kind::AtMostOne && manyPassed)
+    {
+        throw std::runtime_error{concatenate("Mutually exclusive arguments can't be passed together: ",
+                                             describeSlots(constraint, &passed))};
+    }
+
+    if (constraint.kind == Constraint::Kind::AtLeastOne && anyPassed == 0)
+    {
+        throw std::runtime_error{concatenate("At least one of these arguments must be passed: ",
+                                             describeSlots(constraint))};
+    }
+}
+
+inline
+std::string ArgParser::describeSlots(const Constraint &constraint, const SlotSet *filter) const
+{
+    std::string description{};
+    for (std::size_t index = 0; index < constraint.mask.size(); ++index)
+    {
+        for (std::size_t bit = 0; bit < slotsPerWord; ++bit)
+        {
+            const auto slot = (constraint.firstWord + index) * slotsPerWord + bit;
+            if ((constraint.mask[index] >> bit & 1u) != 0 && (filter == nullptr || filter->test(slot)))
+            {
+                description.append(description.empty() ? "[" : ", [").append(configuredArgs.toString(slot))
+                           .push_back(']');
+            }
+        }
+    }
+    return description;
+}
+
+inline
+ArgParser::Choices::Choices(std::vector<std::pair<std::string, std::int64_t>> choices) : choices(std::move(choices))
+{
+    if (this->choices.empty())
+    {
+        throw std::runtime_error{"There must be at least one choice"};
+    }
+
+    // two choices with the same name would make the build below fail forever
+    std::vector<std::string_view> names{};
+    std::transform(this->choices.cbegin(), this->choices.cend(), std::back_inserter(names),
+                   [](const auto &choice) { return std::string_view{choice.first}; });
+    std::sort(names.begin(), names.end());
+    const auto duplicate = std::adjacent_find(names.cbegin(), names.cend());
+    if (duplicate != names.cend())
+    {
+        throw std::runtime_error{concatenate("Duplicate choice: ", *duplicate)};
+    }
+
+    std::size_t slotCount{1};
+    while (slotCount < this->choices.size())
+    {
+        slotCount <<= 1u;
+    }
+    while (!build(slotCount))
+    {
+        slotCount <<= 1u; // a less crowded table always works out eventually
+    }
+}
+
+inline
+bool ArgParser::Choices::build(std::size_t slotCount)
+{
+    // first hash splits names into buckets, then the biggest buckets are placed first with a displacement
+    // (the seed of the second hash) for which all names of bucket land on empty slots
+    static constexpr std::uint32_t MaxDisplacement{1u << 12u};
+    const auto bucketCount = slotCount;
+    std::vector<std::vector<std::uint32_t>> buckets(bucketCount);
+    for (std::uint32_t index = 0; index < choices.size(); ++index)
+    {
+        buckets[hashString(choices[index].first) & (bucketCount - 1)].push_back(index);
+    }
+
+    std::vector<std::uint32_t> order(bucketCount);
+    for (std::uint32_t bucket = 0; bucket < bucketCount; ++bucket)
+    {
+        order[bucket] = bucket;
+    }
+    std::stable_sort(order.begin(), order.end(), [&buckets](std::uint32_t lhs, std::uint32_t rhs)
+    {
+        return buckets[lhs].size() > buckets[rhs].size();
+    });
+
+    displacements.assign(bucketCount, 0);
+    slots.assign(slotCount, 0);
+    std::vector<std::size_t> placed{};
+    for (const auto bucket : order)
+    {
+        if (buckets[bucket].empty())
+        {
+            break;
+        }
+
+        bool found{false};
+        for (std::uint32_t displacement = 1; !found && displacement < MaxDisplacement; ++displacement)
+        {
+            placed.clear();
+            found = true;
+            for (const auto index : buckets[bucket])
+            {
+                const auto slot = hashString(choices[index].first, displacement) & (slotCount - 1);
+                if (slots[slot] != 0)
+                {
+                    found = false;
+                    break;
+                }
+                slots[slot] = index + 1;
+                placed.push_back(slot);
+            }
+
+            if (found)
+            {
+                displacements[bucket] = displacement;
+            }
+            else
+            {
+                for (const auto slot : placed)
+                {
+                    slots[slot] = 0;
+                }
+            }
+        }
+
+        if (!found)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+inline
+std::optional<std::int64_t> ArgParser::Choices::find(std::string_view name) const noexcept
+{
+    const auto displacement = displacements[hashString(name) & (displacements.size() - 1)];
+    const auto index = slots[hashString(name, displacement) & (slots.size() - 1)];
+    if (index != 0 && choices[index - 1].first == name)
+    {
+        return choices[index - 1].second;
+    }
+    return std::nullopt;
+}
+
+inline
+std::string ArgParser::Choices::allowed() const noexcept
+{
+    std::string names{};
+    for (const auto &choice : choices)
+    {
+        names.append(names.empty() ? "" : ", ").append(choice.first);
+    }
+    return names;
+}
+
+inline
+const std::vector<std::pair<std::string, std::int64_t>> &ArgParser::Choices::all() const noexcept
+{
+    return choices;
+}
+
+inline
+const ArgParser::JsonValue *ArgParser::JsonValue::find(std::string_view key) const noexcept
+{
+    const auto it = std::find(keys.cbegin(), keys.cend(), key);
+    return it == keys.cend() ? nullptr : &items[static_cast<std::size_t>(it - keys.cbegin())];
+}
+
+inline
+ArgParser::JsonReader::JsonReader(std::string_view json) : json(json)
+{}
+
+inline
+ArgParser::JsonValue ArgParser::JsonReader::read()
+{
+    auto value = readValue(0);
+    skipSpaces();
+    if (pos != json.size())
+    {
+        fail("end of input");
+    }
+    return value;
+}
+
+inline
+ArgParser::JsonValue ArgParser::JsonReader::readValue(std::size_t depth)
+{
+    if (depth > maxDepth)
+    {
+        fail("less nesting");
+    }
+
+    skipSpaces();
+    JsonValue value{};
+    if (consume("null"))
+    {
+        return value;
+    }
+    if (consume("true"))
+    {
+        value.type = JsonValue::Type::Bool;
+        value.boolean = true;
+        return value;
+    }
+    if (consume("false"))
+    {
+        value.type = JsonValue::Type::Bool;
+        return value;
+    }
+    if (pos < json.size() && json[pos] == '"')
+    {
+        value.type = JsonValue::Type::String;
+        value.text = readString();
+        return value;
+    }
+    if (pos < json.size() && (json[pos] == '-' || std::isdigit(static_cast<unsigned char>(json[pos]))))
+    {
+        value.type = JsonValue::Type::Number;
+        value.text = readNumber();
+        return value;
+    }
+
+    const bool isObject = consume("{");
+    if (!isObject && !consume("["))
+    {
+        fail("a value");
+    }
+    value.type = isObject ? JsonValue::Type::Object : JsonValue::Type::Array;
+    const auto close = isObject ? "}" : "]";
+    skipSpaces();
+    if (consume(close))
+    {
+        return value;
+    }
+    do
+    {
+        if (isObject)
+        {
+            skipSpaces();
+            if (pos >= json.size() || json[pos] != '"')
+            {
+                fail("a key");
+            }
+            value.keys.push_back(readString());
+            skipSpaces();
+            if (!consume(":"))
+            {
+                fail("':'");
+            }
+        }
+        value.items.push_back(readValue(depth + 1));
+        skipSpaces();
+    } while (consume(","));
+    if (!consume(close))
+    {
+        fail(isObject ? "',' or '}'" : "',' or ']'");
+    }
+    return value;
+}
+
+inline
+std::string ArgParser::JsonReader::readString()
+{
+    std::string str{};
+    ++pos; // opening quote
+    while (pos < json.size() && json[pos] != '"')
+    {
+        const auto c = static_cast<unsigned char>(json[pos++]);
+        if (c < 0x20u)
+        {
+            fail("an escaped control character");
+        }
+        if (c != '\\')
+        {
+            str += static_cast<char>(c);
+            continue;
+        }
+        if (pos >= json.size())
+        {
+            break;
+        }
+        switch (json[pos++])
+        {
+            case '"': str += '"'; break;
+            case '\\': str += '\\'; break;
+            case '/': str += '/'; break;
+            case 'b': str += '\b'; break;
+            case 'f': str += '\f'; break;
+            case 'n': str += '\n'; break;
+            case 'r': str += '\r'; break;
+            case 't': str += '\t'; break;
+            case 'u':
+            {
+                auto codePoint = readCodeUnit();
+                if (codePoint >= 0xDC00u && codePoint <= 0xDFFFu)
+                {
+                    fail("a high surrogate before a low one");
+                }
+                if (codePoint >= 0xD800u && codePoint <= 0xDBFFu)
+                {
+                    if (!consume("\\u"))
+                    {
+                        fail("a low surrogate");
+                    }
+                    const auto low = readCodeUnit();
+                    if (low < 0xDC00u || low > 0xDFFFu)
+                    {
+                        fail("a low surrogate");
+                    }
+                    codePoint = 0x10000u + ((codePoint - 0xD800u) << 10u) + (low - 0xDC00u);
+                }
+                // as UTF-8
+                if (codePoint < 0x80u)
+                {
+                    str += static_cast<char>(codePoint);
+                }
+                else if (codePoint < 0x800u)
+                {
+                    str += static_cast<char>(0xC0u | codePoint >> 6u);
+                    str += static_cast<char>(0x80u | (codePoint & 0x3Fu));
+                }
+                else if (codePoint < 0x10000u)
+                {
+                    str += static_cast<char>(0xE0u | codePoint >> 12u);
+                    str += static_cast<char>(0x80u | (codePoint >> 6u & 0x3Fu));
+                    str += static_cast<char>(0x80u | (codePoint & 0x3Fu));
+                }
+                else
+                {
+                    str += static_cast<char>(0xF0u | codePoint >> 18u);
+                    str += static_cast<char>(0x80u | (codePoint >> 12u & 0x3Fu));
+                    str += static_cast<char>(0x80u | (codePoint >> 6u & 0x3Fu));
+                    str += static_cast<char>(0x80u | (codePoint & 0x3Fu));
+                }
+                break;
+            }
+            default:
+                --pos;
+                fail("a valid escape");
+        }
+    }
+    if (!consume("\""))
+    {
+        fail("closing '\"'");
+    }
+    return str;
+}
+
+inline
+std::string ArgParser::JsonReader::readNumber()
+{
+    // -?(0|[1-9][0-9]*)(.[0-9]+)?([eE][+-]?[0-9]+)?
+    const auto start = pos;
+    const auto digits = [this]()
+    {
+        const auto first = pos;
+        while (pos < json.size() && std::isdigit(static_cast<unsigned char>(json[pos])))
+        {
+            ++pos;
+        }
+        return pos - first;
+    };
+
+    consume("-");
+    const auto integerStart = pos;
+    const auto integerDigits = digits();
+    if (integerDigits == 0 || (integerDigits > 1 && json[integerStart] == '0'))
+    {
+        fail("a number");
+    }
+    if (consume(".") && digits() == 0)
+    {
+        fail("digits after '.'");
+    }
+    if (consume("e") || consume("E"))
+    {
+        consume("+") || consume("-");
+        if (digits() == 0)
+        {
+            fail("digits of exponent");
+        }
+    }
+    return std::string{json.substr(start, pos - start)};
+}
+
+inline
+std::uint32_t ArgParser::JsonReader::readCodeUnit()
+{
+    std::uint32_t codeUnit{0};
+    const auto [end, ec] = std::from_chars(json.data() + pos, json.data() + std::min(pos + 4, json.size()),
+                                           codeUnit, 16);
+    if (ec != std::errc{} || end != json.data() + pos + 4)
+    {
+        fail("4 hex digits");
+    }
+    pos += 4;
+    return codeUnit;
+}
+
+inline
+void ArgParser::JsonReader::skipSpaces() noexcept
+{
+    while (pos < json.size() && (json[pos] == ' ' || json[pos] == '\t' || json[pos] == '\n' || json[pos] == '\r'))
+    {
+        ++pos;
+    }
+}
+
+inline
+bool ArgParser::JsonReader::consume(std::string_view token) noexcept
+{
+    if (json.substr(pos, token.size()) != token)
+    {
+        return false;
+    }
+    pos += token.size();
+    return true;
+}
+
+inline
+void ArgParser::JsonReader::fail(std::string_view expected) const
+{
+    throw std::runtime_error{concatenate("Invalid schema JSON at offset ", pos, ", expected ", expected)};
+}
+
+inline
+constexpr std::uint64_t ArgParser::hashString(std::string_view str, std::uint64_t seed) noexcept
+{
+    std::uint64_t hashed{14695981039346656037ull ^ (seed * 0x9E3779B97F4A7C15ull)};
+    for (const auto c : str)
+    {
+        hashed = (hashed ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+    }
+    hashed ^= hashed >> 33u;
+    hashed *= 0xFF51AFD7ED558CCDull;
+    hashed ^= hashed >> 33u;
+    return hashed;
+}
+
+inline
+ArgParser::SlotSet::SlotSet(std::size_t slotCount) : words((slotCount + slotsPerWord - 1) / slotsPerWord, 0)
+{}
+
+inline
+void ArgParser::SlotSet::set(std::size_t slot)
+{
+    words[slot / slotsPerWord] |= std::uint64_t{1} << (slot % slotsPerWord);
+}
+
+inline
+bool ArgParser::SlotSet::test(std::size_t slot) const noexcept
+{
+    return (words[slot / slotsPerWord] >> (slot % slotsPerWord) & 1u) != 0;
+}
+
+inline
+std::uint64_t ArgParser::SlotSet::word(std::size_t index) const noexcept
+{
+    return words[index];
+}
+
+inline
+void ArgParser::Constraint::add(std::size_t slot)
+{
+    const auto index = slot / slotsPerWord;
+    if (mask.empty())
+    {
+        firstWord = index;
+    }
+    else if (index < firstWord)
+    {
+        mask.insert(mask.begin(), firstWord - index, 0);
+        firstWord = index;
+    }
+    if (index - firstWord >= mask.size())
+    {
+        mask.resize(index - firstWord + 1, 0);
+    }
+    mask[index - firstWord] |= std::uint64_t{1} << (slot % slotsPerWord);
+}
+
+inline
+const std::string &ArgParser::getAppPath() const noexcept
+{
+    return appPath;
+}
+
+template<typename T>
+std::string ArgParser::to_string(T &&arg) noexcept
+{
+    // std::decay to remove cv and reference qualifiers
+    if constexpr(std::is_same_v<std::decay_t<T>, std::string>) return arg;
+    else if constexpr(std::is_constructible_v<std::string, std::decay_t<T>>) return std::string{std::forward<T>(arg)};
+    else if constexpr(std::is_same_v<char, std::decay_t<T>>) return {arg};
+    else if constexpr(std::is_same_v<bool, std::decay_t<T>>) return arg ? truthy : falsy;
+    else if constexpr(std::is_same_v<ByteSize, std::decay_t<T>>) return quantity_to_string(arg.bytes, byteUnits);
+    else if constexpr(std::is_same_v<Count, std::decay_t<T>>) return quantity_to_string(arg.value, countUnits);
+    else if constexpr(std::is_same_v<Rate, std::decay_t<T>>)
+    {
+        // exact and locale independent, so that it is parsed back to the same value
+        std::ostringstream rate{};
+        rate.imbue(std::locale::classic());
+        rate << std::setprecision(std::numeric_limits<double>::max_digits10) << arg.perSecond << "/s";
+        return rate.str();
+    }
+    else if constexpr(IsDuration<std::decay_t<T>>::value)
+    {
+        using Period = typename std::decay_t<T>::period;
+        const auto unit = std::find_if(std::begin(timeUnits), std::end(timeUnits), [](const Unit &unit)
+        {
+            return unit.num == static_cast<std::uint64_t>(Period::num)
+                   && unit.den == static_cast<std::uint64_t>(Period::den);
+        });
+        // without a unit, it is in the period of the duration
+        return std::to_string(arg.count()).append(unit == std::end(timeUnits) ? "" : unit->name);
+    }
+    // otherwise all we support is arithmetic values, let std::to_string take care of issues
+    else return std::to_string(std::forward<T>(arg)); // wow! this was fun! without else, return fails to compile!
+}
+
+template<typename ...Ts>
+std::string ArgParser::concatenate(Ts &&...args) noexcept
+{
+    // This is inefficient compared to fmt::format, but we need to keep this header only library
+    // and btw, this happens only in error cases
+    return (ArgParser::to_string(std::forward<Ts>(args)) + ...);
+}
+
+inline
+ArgParser::Arg::Arg(const std::string &shortArg, const std::string &longArg, std::string helpMsg, bool isMandatory) :
+        helpMsg(std::move(helpMsg)),
+        hasDefault(false),
+        mandatory(isMandatory)
+{
+    init_args(shortArg, longArg);
+}
+
+inline
+ArgParser::Arg::Arg(const std::string &shortArg, const std::string &longArg, std::string helpMsg,
+                    std::string defaultValue) :
+        helpMsg(std::move(helpMsg)),
+        defaultValue(std::move(defaultValue)),
+        hasDefault(true)
+{
+    init_args(shortArg, longArg);
+}
+
+inline
+const std::string &ArgParser::Arg::getShortOpt() const noexcept
+{
+    return shortOpt;
+}
+
+inline
+const std::string &ArgParser::Arg::getLongOpt() const noexcept
+{
+    return longOpt;
+}
+
+inline
+const std::string &ArgParser::Arg::getHelpMsg() const noexcept
+{
+    return helpMsg;
+}
+
+inline
+std::string ArgParser::Arg::toString() const noexcept
+{
+    return concatenate('-', shortOpt, ", --", longOpt);
+}
+
+inline
+bool ArgParser::Arg::hasDefaultValue() const noexcept
+{
+    return hasDefault;
+}
+
+inline
+const std::string &ArgParser::Arg::getDefaultValue() const
+{
+    if (hasDefaultValue())
+    {
+        return defaultValue;
+    }
+    throw std::runtime_error{concatenate("There was no default set for: ", toString())};
+}
+
+inline
+void ArgParser::Arg::init_args(const std::string &shortArg, const std::string &longArg)
+{
+    // @shortArg and @longArg are only being forwarded till ParsedArg::parse_arg
+    // hence, it is better to accept them as reference to const std::string instead of keep moving
+    const auto shortParsedArg = ParsedArg::parse_arg(shortArg);
+    const auto longParsedArg = ParsedArg::parse_arg(longArg);
+
+    if (shortParsedArg.argType != ArgTypeEnum::Short)
+    {
+        throw std::runtime_error{concatenate("Invalid short option: ", shortArg)};
+    }
+
+    if (longParsedArg.argType != ArgTypeEnum::Long)
+    {
+        throw std::runtime_error{concatenate("Invalid long option: ", longArg)};
+    }
+
+    // both can't be same parsed arguments
+    if (shortParsedArg.parsedArg.size() >= longParsedArg.parsedArg.size())
+    {
+        throw std::runtime_error{
+                concatenate("Short option [", shortArg, "] must be shorter than Long option [", longArg, ']')};
+    }
+    shortOpt = shortParsedArg.parsedArg;
+    longOpt = longParsedArg.parsedArg;
+}
+
+inline
+bool ArgParser::Arg::isMandatory() const noexcept
+{
+    return mandatory;
+}
+
+inline
+std::size_t ArgParser::ArgTable::add(const Arg &arg)
+{
+    const auto slot = static_cast<std::uint32_t>(shortOpts.size());
+    shortOpts.push_back(append(arg.getShortOpt()));
+    longOpts.push_back(append(arg.getLongOpt()));
+    helpMsgs.push_back(intern(arg.getHelpMsg()));
+    defaultValues.push_back(arg.hasDefaultValue() ? intern(arg.getDefaultValue()) : StringRef{});
+    flags.push_back(static_cast<std::uint8_t>((arg.hasDefaultValue() ? HasDefault : 0) |
+                                              (arg.isMandatory() ? Mandatory : 0)));
+
+    const auto nameKey = [this](std::uint32_t entry) { return nameOf(entry); };
+    for (const std::uint32_t isLong : {0u, 1u})
+    {
+        growIfNeeded(nameBuckets, 2 * slot + isLong);
+        const auto entry = (slot << 1u | isLong) + 1;
+        const auto hash = hashString(nameOf(entry));
+        nameBuckets[probe(nameBuckets, nameOf(entry), hash, nameKey)] = bucketOf(hash, entry);
+    }
+    return slot;
+}
+
+inline
+void ArgParser::ArgTable::reserve(std::size_t count, std::size_t stringSize)
+{
+    const auto slotCount = size() + count;
+    shortOpts.reserve(slotCount);
+    longOpts.reserve(slotCount);
+    helpMsgs.reserve(slotCount);
+    defaultValues.reserve(slotCount);
+    flags.reserve(slotCount);
+    pool.reserve(pool.size() + stringSize);
+    // help messages and default values are mostly shared, so only the names are known to need room
+    growIfNeeded(nameBuckets, 2 * slotCount);
+}
+
+inline
+void ArgParser::ArgTable::truncate(std::size_t slotCount)
+{
+    if (slotCount >= size())
+    {
+        return;
+    }
+
+    // everything added to @pool since, starts with the short option of the first removed argument
+    const auto poolSize = shortOpts[slotCount].offset;
+    pool.resize(poolSize);
+    shortOpts.resize(slotCount);
+    longOpts.resize(slotCount);
+    helpMsgs.resize(slotCount);
+    defaultValues.resize(slotCount);
+    flags.resize(slotCount);
+    interned.erase(std::find_if(interned.cbegin(), interned.cend(), [poolSize](StringRef ref)
+    {
+        return ref.offset >= poolSize;
+    }), interned.cend());
+
+    // removed entries may be anywhere in the probe sequences of the kept ones, so these are put back
+    std::fill(internBuckets.begin(), internBuckets.end(), 0);
+    for (std::uint32_t entry = 1; entry <= interned.size(); ++entry)
+    {
+        insertNew(internBuckets, bucketOf(hashString(view(interned[entry - 1])), entry));
+    }
+    std::fill(nameBuckets.begin(), nameBuckets.end(), 0);
+    for (std::uint32_t entry = 1; entry <= 2 * slotCount; ++entry)
+    {
+        insertNew(nameBuckets, bucketOf(hashString(nameOf(entry)), entry));
+    }
+}
+
+inline
+std::vector<std::size_t> ArgParser::ArgTable::firstOccurrences(const std::vector<std::string_view> &names)
+{
+    std::vector<std::size_t> firstOf(names.size());
+    std::vector<std::uint64_t> buckets{};
+    growIfNeeded(buckets, names.size());
+
+    // entry is index in @names plus one
+    const auto nameKey = [&names](std::uint32_t entry) { return names[entry - 1]; };
+    for (std::size_t i = 0; i < names.size(); ++i)
+    {
+        const auto hash = hashString(names[i]);
+        auto &bucket = buckets[probe(buckets, names[i], hash, nameKey)];
+        if (bucket == 0)
+        {
+            bucket = bucketOf(hash, static_cast<std::uint32_t>(i + 1));
+        }
+        firstOf[i] = entryOf(bucket) - 1;
+    }
+    return firstOf;
+}
+
+inline
+std::size_t ArgParser::ArgTable::size() const noexcept
+{
+    return shortOpts.size();
+}
+
+inline
+std::size_t ArgParser::ArgTable::find(std::string_view name) const noexcept
+{
+    if (nameBuckets.empty())
+    {
+        return npos;
+    }
+    const auto bucket = probe(nameBuckets, name, hashString(name),
+                              [this](std::uint32_t entry) { return nameOf(entry); });
+    const auto entry = entryOf(nameBuckets[bucket]);
+    return entry == 0 ? npos : (entry - 1) >> 1u;
+}
+
+inline
+std::size_t ArgParser::ArgTable::find(std::string_view name, ArgTypeEnum type) const noexcept
+{
+    const auto slot = find(name);
+    if (slot == npos || (type == ArgTypeEnum::Long ? longOpt(slot) : shortOpt(slot)) != name)
+    {
+        return npos;
+    }
+    return slot;
+}
+
+inline
+std::string_view ArgParser::ArgTable::shortOpt(std::size_t slot) const noexcept
+{
+    return view(shortOpts[slot]);
+}
+
+inline
+std::string_view ArgParser::ArgTable::longOpt(std::size_t slot) const noexcept
+{
+    return view(longOpts[slot]);
+}
+
+inline
+std::string_view ArgParser::ArgTable::helpMsg(std::size_t slot) const noexcept
+{
+    return view(helpMsgs[slot]);
+}
+
+inline
+bool ArgParser::ArgTable::hasDefaultValue(std::size_t slot) const noexcept
+{
+    return (flags[slot] & HasDefault) != 0;
+}
+
+inline
+std::string_view ArgParser::ArgTable::defaultValue(std::size_t slot) const noexcept
+{
+    return view(defaultValues[slot]);
+}
+
+inline
+bool ArgParser::ArgTable::isMandatory(std::size_t slot) const noexcept
+{
+    return (flags[slot] & Mandatory) != 0;
+}
+
+inline
+bool ArgParser::ArgTable::affectsOutput(std::size_t slot) const noexcept
+{
+    return (flags[slot] & NotAffectingOutput) == 0;
+}
+
+inline
+void ArgParser::ArgTable::excludeFromOutput(std::size_t slot) noexcept
+{
+    flags[slot] |= NotAffectingOutput;
+}
+
+inline
+std::string ArgParser::ArgTable::toString(std::size_t slot) const noexcept
+{
+    return concatenate('-', shortOpt(slot), ", --", longOpt(slot));
+}
+
+inline
+std::string ArgParser::ArgTable::toVerboseString(std::size_t slot) const noexcept
+{
+    if (hasDefaultValue(slot))
+    {
+        return concatenate(toString(slot), "\n\tdescription: ", helpMsg(slot), ", default: ", defaultValue(slot));
+    }
+
+    if (isMandatory(slot))
+    {
+        return concatenate(toString(slot), "\n\tdescription: ", helpMsg(slot), ", mandatory: true");
+    }
+
+    return concatenate(toString(slot), "\n\tdescription: ", helpMsg(slot));
+}
+
+inline
+ArgParser::StringRef ArgParser::ArgTable::intern(std::string_view str)
+{
+    growIfNeeded(internBuckets, interned.size());
+
+    const auto hash = hashString(str);
+    const auto bucket = probe(internBuckets, str, hash, [this](std::uint32_t entry)
+    {
+        return view(interned[entry - 1]);
+    });
+    if (internBuckets[bucket] != 0)
+    {
+        return interned[entryOf(internBuckets[bucket]) - 1];
+    }
+
+    const auto ref = append(str);
+    interned.push_back(ref);
+    internBuckets[bucket] = bucketOf(hash, static_cast<std::uint32_t>(interned.size()));
+    return ref;
+}
+
+inline
+ArgParser::StringRef ArgParser::ArgTable::append(std::string_view str)
+{
+    if (pool.size() + str.size() > UINT32_MAX)
+    {
+        throw std::runtime_error{"Configured arguments don't fit in 32 bit offsets"};
+    }
+    const StringRef ref{static_cast<std::uint32_t>(pool.size()), static_cast<std::uint32_t>(str.size())};
+    pool.append(str);
+    return ref;
+}
+
+inline
+std::string_view ArgParser::ArgTable::view(StringRef ref) const noexcept
+{
+    return std::string_view{pool}.substr(ref.offset, ref.size);
+}
+
+inline
+std::string_view ArgParser::ArgTable::nameOf(std::uint32_t entry) const noexcept
+{
+    const auto slot = (entry - 1) >> 1u;
+    return ((entry - 1) & 1u) != 0 ? longOpt(slot) : shortOpt(slot);
+}
+
+inline
+constexpr std::uint64_t ArgParser::ArgTable::bucketOf(std::uint64_t hash, std::uint32_t entry) noexcept
+{
+    return (hash & 0xFFFFFFFF00000000ull) | entry;
+}
+
+inline
+constexpr std::uint32_t ArgParser::ArgTable::entryOf(std::uint64_t bucket) noexcept
+{
+    return static_cast<std::uint32_t>(bucket);
+}
+
+template<typename KeyOf>
+std::size_t ArgParser::ArgTable::probe(const std::vector<std::uint64_t> &buckets, std::string_view key,
+                                       std::uint64_t hash, KeyOf keyOf)
+{
+    // only the higher 32 bits are kept in bucket, these pick the bucket and are compared before the keys
+    const auto mask = buckets.size() - 1;
+    auto index = static_cast<std::size_t>(hash >> 32u) & mask;
+    while (buckets[index] != 0 &&
+           (bucketOf(hash, 0) != bucketOf(buckets[index], 0) || keyOf(entryOf(buckets[index])) != key))
+    {
+        index = (index + 1) & mask;
+    }
+    return index;
+}
+
+inline
+void ArgParser::ArgTable::growIfNeeded(std::vector<std::uint64_t> &buckets, std::size_t entryCount)
+{
+    if (2 * (entryCount + 1) <= buckets.size())
+    {
+        return;
+    }
+
+    auto size = std::max<std::size_t>(16, buckets.size());
+    while (2 * (entryCount + 1) > size)
+    {
+        size *= 2;
+    }
+
+    std::vector<std::uint64_t> grown(size, 0);
+    for (const auto bucket : buckets)
+    {
+        if (bucket != 0)
+        {
+            insertNew(grown, bucket);
+        }
+    }
+    buckets.swap(grown);
+}
+
+inline
+void ArgParser::ArgTable::insertNew(std::vector<std::uint64_t> &buckets, std::uint64_t bucket) noexcept
+{
+    const auto mask = buckets.size() - 1;
+    auto index = static_cast<std::size_t>(bucket >> 32u) & mask;
+    while (buckets[index] != 0)
+    {
+        index = (index + 1) & mask;
+    }
+    buckets[index] = bucket;
+}
+
+inline
+ArgParser::ParsedArg ArgParser::ParsedArg::parse_arg(std::string_view arg)
+{
+    static constexpr char us = '_';
+
+    const auto pos = arg.find_first_not_of('-');
+    if (pos == 0 || pos == std::string_view::npos)
+    {
+        return ParsedArg{ArgTypeEnum::Invalid, std::string{arg}};
+    }
+
+    if (!std::all_of(std::next(arg.cbegin(), static_cast<long>(pos)), arg.cend(),
+                     [](unsigned char c) { return std::isalnum(c) || c == us; }))
+    {
+        return ParsedArg{ArgTypeEnum::Invalid, std::string{arg}};
+    }
+
+    if (pos == 1)
+    {
+        return ParsedArg{ArgTypeEnum::Short, std::string{arg.substr(pos)}};
+    }
+
+    if (pos == 2)
+    {
+        return ParsedArg{ArgTypeEnum::Long, std::string{arg.substr(pos)}};
+    }
+
+    return ParsedArg{ArgTypeEnum::Invalid, std::string{arg}};
+}
+
+/*
+ * Read only view of a blob created by ArgParser::snapshot(), e.g. in a worker process:
+ *      ArgSnapshot snapshot{std::string_view{mappedFile, mappedSize}};
+ *      const auto waitTime = snapshot.retrieve<int>("waitTime");
+ *
+ * Nothing is parsed or copied, values are converted straight from the blob, which must outlive the snapshot
+ * Retrieval behaves the same as ArgParser::retrieve
+ * */
+class ArgSnapshot
+{
+public:
+    // It will throw exception if @blob is not a snapshot or was created by an incompatible version
+    explicit ArgSnapshot(std::string_view blob);
 
-    // To retrieve value corresponding to @arg
-    // If returned value is std::nullopt, it could be because:
-    //  - @arg was not configured/passed
-    //  - conversion from std::string to type T failed
-    // All values of arguments are stored as std::string, hence conversion to std::string always succeeds
-    // throws iff it is called before calling parse()
+    // Same as ArgParser::retrieve, returns std::nullopt if @arg was not parsed or conversion failed
     template<typename T = std::string>
-    std::optional<T> retrieve(const std::string &arg) const;
+    std::optional<T> retrieve(const std::string &arg) const noexcept;
 
-    // Retrieves the value for @arg and throws if:
-    //   - conversion to type T fails
-    //   - the arg was not configured/passed
-    //   - this was called before parse()
+    // Same as ArgParser::retrieveMayThrow
     template<typename T = std::string>
     T retrieveMayThrow(const std::string &arg) const;
 
-    // To get the help message for this application with configured arguments
-    std::string helpMsg() const noexcept;
-
-    // Returns true if application was called with -h or --help
-    bool needHelp() const noexcept;
-
-    // To get the description of application, the argument of the parameterized constructor
-    const std::string &getDescription() const noexcept;
-
-    // Returns true if the application was run with @arg as one of command line arguments
+    // Returns true if @arg has a value in the snapshot
     bool contains(const std::string &arg) const noexcept;
 
+    // The app path of parsed command line arguments
+    std::string_view getAppPath() const noexcept;
+
 private:
+    std::uint32_t readU32(std::size_t pos) const noexcept;
 
-    // Following is a set of helper classes and enum
-    // We don't need to expose these to the user, hence made them private
-    //  - little difficult to read and maintain, but better for user
-    //  - user just sees the public function of ArgParser
-    enum class ArgTypeEnum
-    {
-        Short,
-        Long,
-        Invalid
-    };
+    // returns the string at @pos, which points to the offset followed by size
+    std::string_view readString(std::size_t pos) const noexcept;
 
-    struct ParsedArg
-    {
-        ArgTypeEnum argType;
-        std::string parsedArg;
+    // returns the position of the entry of @arg
+    std::optional<std::size_t> find(const std::string &arg) const noexcept;
 
-        static ParsedArg parse_arg(const std::string &arg);
-    };
+    std::string_view blob;
+    std::size_t entryCount{0};
+    char listDelimiter{','};
+};
 
-    // A class which deals with parsing configured arguments
-    class Arg
+inline
+ArgSnapshot::ArgSnapshot(std::string_view blob) : blob(blob)
+{
+    if (blob.size() < ArgParser::snapshotHeaderSize || blob.substr(0, 4) != ArgParser::snapshotMagic)
     {
-    public:
-
-        explicit Arg(const std::string &shortArg, const std::string &longArg, std::string helpMsg,
-                     bool isMandatory = false);
-
-        explicit Arg(const std::string &shortArg, const std::string &longArg, std::string helpMsg,
-                     std::string defaultValue);
+        throw std::runtime_error{"Invalid snapshot of parsed arguments"};
+    }
 
-        bool operator==(const Arg& rhs) const noexcept;
+    const auto version = readU32(4);
+    if (version != ArgParser::snapshotVersion)
+    {
+        throw std::runtime_error{ArgParser::concatenate("Unsupported snapshot version: ", version)};
+    }
 
-        bool operator!=(const Arg& rhs) const noexcept;
+    entryCount = readU32(16);
+    listDelimiter = static_cast<char>(readU32(20));
+    const auto tableEnd = ArgParser::snapshotHeaderSize + entryCount * ArgParser::snapshotEntrySize;
+    if (tableEnd > blob.size())
+    {
+        throw std::runtime_error{"Truncated snapshot of parsed arguments"};
+    }
 
-        bool operator<(const Arg& rhs) const noexcept;  // useful when Arg will be key inside std::map
+    // check all the strings once, so that retrieval doesn't need to
+    const auto isValidString = [this](std::size_t pos)
+    {
+        const std::size_t offset = readU32(pos);
+        return offset <= this->blob.size() && readU32(pos + 4) <= this->blob.size() - offset;
+    };
 
-        [[nodiscard]] const std::string &getShortOpt() const noexcept;
+    bool isValid = isValidString(8);
+    for (std::size_t pos = ArgParser::snapshotHeaderSize; pos < tableEnd; pos += ArgParser::snapshotEntrySize)
+    {
+        isValid = isValid && isValidString(pos) && isValidString(pos + 8) && isValidString(pos + 16);
+    }
+    if (!isValid)
+    {
+        throw std::runtime_error{"Truncated snapshot of parsed arguments"};
+    }
+}
 
-        [[nodiscard]] const std::string &getLongOpt() const noexcept;
+template<typename T>
+std::optional<T> ArgSnapshot::retrieve(const std::string &arg) const noexcept
+{
+    const auto entry = find(arg);
+    if (!entry)
+    {
+        return std::nullopt;
+    }
 
-        [[nodiscard]] bool match(const ParsedArg &arg) const;
+    // same as ArgParser::convertSlot, with choices resolved by ArgParser::snapshot
+    if constexpr(ArgParser::IsList<T>::value)
+    {
+        return ArgParser::from_list<typename T::value_type>(readString(*entry + 16), listDelimiter);
+    }
 
-        [[nodiscard]] bool match(const std::string &arg) const noexcept;
+    if constexpr(ArgParser::isChoiceType<T>)
+    {
+        if (readU32(*entry + 24) != 0)
+        {
+            const auto bits = readU32(*entry + 28) | (static_cast<std::uint64_t>(readU32(*entry + 32)) << 32u);
+            return static_cast<T>(static_cast<std::int64_t>(bits));
+        }
+    }
+    return ArgParser::from_string<T>(readString(*entry + 16));
+}
 
-        [[nodiscard]] bool hasDefaultValue() const noexcept;
+template<typename T>
+T ArgSnapshot::retrieveMayThrow(const std::string &arg) const
+{
+    const auto retrieved_opt = retrieve<T>(arg);
+    if (retrieved_opt)
+    {
+        return *retrieved_opt;
+    }
+    throw std::runtime_error{ArgParser::concatenate("Type conversion failed for ", arg)};
+}
 
-        // throws exception if no default value is set
-        [[nodiscard]] const std::string &getDefaultValue() const;
+inline
+bool ArgSnapshot::contains(const std::string &arg) const noexcept
+{
+    return find(arg).has_value();
+}
 
-        [[nodiscard]] std::string toString() const noexcept;
+inline
+std::string_view ArgSnapshot::getAppPath() const noexcept
+{
+    return readString(8);
+}
 
-        [[nodiscard]] std::string toVerboseString() const noexcept;
+inline
+std::uint32_t ArgSnapshot::readU32(std::size_t pos) const noexcept
+{
+    std::uint32_t value{0};
+    for (int byte = 3; byte >= 0; --byte)
+    {
+        value = (value << 8u) | static_cast<unsigned char>(blob[pos + static_cast<std::size_t>(byte)]);
+    }
+    return value;
+}
 
-        // Returns true if the argument is mandatory
-        [[nodiscard]] bool isMandatory() const noexcept;
+inline
+std::string_view ArgSnapshot::readString(std::size_t pos) const noexcept
+{
+    return blob.substr(readU32(pos), readU32(pos + 4));
+}
 
-    private:
-        void init_args(const std::string &shortArg, const std::string &longArg);
+inline
+std::optional<std::size_t> ArgSnapshot::find(const std::string &arg) const noexcept
+{
+    // same as ArgParser::retrieve, a linear search as there are always only few arguments
+    for (std::size_t entry = 0; entry < entryCount; ++entry)
+    {
+        const auto pos = ArgParser::snapshotHeaderSize + entry * ArgParser::snapshotEntrySize;
+        if (readString(pos) == arg || readString(pos + 8) == arg)
+        {
+            return pos;
+        }
+    }
+    return std::nullopt;
+}
 
-        std::string shortOpt{};
-        std::string longOpt{};
-        std::string helpMsg{};
-        std::string defaultValue{};
-        bool hasDefault{false};
-        bool mandatory{false};
-    };
+/*
+ * Values of one tenant over a parsed ArgParser which is shared by all the tenants, e.g. of a server:
+ *      ArgOverlay tenant{base};
+ *      tenant.set("waitTime", 20);
+ *      const auto waitTime = tenant.retrieve<int>("waitTime"); // 20, others have the values of base
+ *
+ * Only the values set on the overlay are kept, sorted by slot same as ArgParser::setOverride, so memory grows
+ * with the number of these values and not with the number of arguments
+ * A mask of the set slots (slot % 64) sends retrieval of a value which isn't set straight to @base, without a
+ * search, and the search otherwise is a binary search over the few values of this overlay
+ * A set value takes precedence over everything in @base, passed values included
+ * With interpolation enabled on @base, set values are expanded, and so are values of @base which reference them,
+ * against the values of the overlay. These are expanded by @set and @reset, which throw the same errors as
+ * ArgParser::setOverride for them, and take the change back in that case
+ * @base must outlive the overlay and must not be parsed again while it is in use
+ * Retrieval behaves the same as ArgParser::retrieve, and it is safe from many threads while nothing is set
+ * */
+class ArgOverlay
+{
+public:
+    // It will throw exception if @base can't be retrieved from, for the same reasons as ArgParser::retrieve
+    explicit ArgOverlay(const ArgParser &base);
 
-    // To convert a type into std::string, can't be dependent on just std::string
-    // as it is callable only on numeric types
-    // a helper for @concatenate method
+    // Value of @arg for this overlay, it replaces the one set earlier, @base is not modified
+    // It will throw exception if @arg is not configured, @value is not one of its choices, or its references can't
+    // be expanded
     template<typename T>
-    static std::string to_string(T &&arg) noexcept;
-
-    // To concatenate strings, fmt::format would have been ideal
-    // but we need to keep this header only library
-    template<typename ...Ts>
-    static std::string concatenate(Ts &&...args) noexcept;
-
-    // preprocess to ensure that help works as expected
-    void init() noexcept;
+    ArgOverlay &set(const std::string &arg, const T &value);
 
-    // ensures that parse() was called or if there was application was called with -h or --help
-    void validateRetrieval() const;
+    // Removes the value of @arg set on this overlay, so that it has the value of @base again
+    // It will throw exception if @arg is not configured, or the references of values can't be expanded without it
+    ArgOverlay &reset(const std::string &arg);
 
-    // check if all the mandatory arguments have been passed, throws otherwise
-    void checkMandatoryArgs() const;
-
-    // parses a key=value pair, throws iff format is incorrect
-    static std::pair<ParsedArg, std::string> argValueParser(const std::string &arg);
+    // Same as ArgParser::retrieve, values which are not set on this overlay are retrieved from @base
+    template<typename T = std::string>
+    std::optional<T> retrieve(const std::string &arg) const;
 
-    // finds the arg from list of configured args
-    std::optional<Arg> findArg(const ParsedArg &arg) const noexcept;
+    template<typename T>
+    std::optional<T> retrieve(ArgParser::Opt<T> opt) const;
 
-    static bool isHelpString(const std::string &arg) noexcept;
+    // Same as ArgParser::retrieveMayThrow
+    template<typename T = std::string>
+    T retrieveMayThrow(const std::string &arg) const;
 
-    ArgParser &addArgumentImpl(Arg &&arg);
+    // Number of values set on this overlay
+    std::size_t size() const noexcept;
 
-    // To convert from std::string to type T
-    // Following is how it is different from std::from_string:
-    //  - conversion to bool from "true" or "false" is supported
-    //  - conversion to char succeeds only if arg.size() is 1
-    //  - of course, if T is std::string, arg is returned
-    // for all numerical types, the behavior is same as that of std::from_string
+private:
     template<typename T>
-    static std::optional<T> from_string(const std::string &arg) noexcept;
+    std::optional<T> retrieveSlot(std::size_t slot) const;
 
-    // To describe the app
-    std::string description;
+    // the value set for @slot, std::nullopt if it falls through to @base
+    std::optional<std::string_view> find(std::size_t slot) const noexcept;
 
-    // To keep the configured arguments
-    std::vector<Arg> configuredArgs{};
+    // the value for @slot in @entries which are sorted by slot
+    static std::optional<std::string_view> findIn(const std::vector<std::pair<std::size_t, std::string>> &entries,
+                                                  std::size_t slot) noexcept;
 
-    // Used to ensure that any combination of configured arguments don't match with others
-    std::unordered_set<std::string> argKeys{};
+    // expands @values and the values of @base which reference them into @expanded, if interpolation is enabled
+    void expand();
 
-    // Used to keep the configured argument against their passed values in command line arguments
-    std::map<ArgParser::Arg, std::string> parsedArgs{};
-    std::string appPath{};
-    bool isOnlyHelpString{false};
+    static std::uint64_t maskOf(std::size_t slot) noexcept;
 
-    static constexpr auto truthy = "true";
-    static constexpr auto falsy = "false";
+    const ArgParser *base;
+    std::uint64_t setSlots{0};
+    std::vector<std::pair<std::size_t, std::string>> values{};
+    std::vector<std::pair<std::size_t, std::string>> expanded{}; // sorted by slot, same as @values
 };
 
 inline
-ArgParser &ArgParser::addArgument(const std::string &shortOpt, const std::string &longOpt, const std::string &helpMsg,
-                                  bool isMandatory)
+ArgOverlay::ArgOverlay(const ArgParser &base) : base(&base)
 {
-    return addArgumentImpl(Arg{shortOpt, longOpt, helpMsg, isMandatory});
+    base.validateRetrieval();
 }
 
 template<typename T>
-ArgParser &ArgParser::addArgumentWithDefault(const std::string &shortOpt, const std::string &longOpt,
-                                             const std::string &helpMsg, const T &defaultValue)
+ArgOverlay &ArgOverlay::set(const std::string &arg, const T &value)
 {
-    return addArgumentImpl(Arg{shortOpt, longOpt, helpMsg, to_string(defaultValue)});
-}
+    const auto slot = base->configuredSlotOf(arg);
+    auto str = ArgParser::to_string(value);
+    base->resolveChoice(slot, str);
 
-inline
-ArgParser &ArgParser::addArgumentImpl(Arg &&arg)
-{
-    if (!argKeys.emplace(arg.getShortOpt()).second || !argKeys.emplace(arg.getLongOpt()).second)
+    const auto it = std::lower_bound(values.begin(), values.end(), slot, [](const auto &entry, auto key)
     {
-        throw std::runtime_error{concatenate("Duplicate arguments: ", arg.toString())};
+        return entry.first < key;
+    });
+    const auto isSet = it != values.end() && it->first == slot;
+    auto previous = isSet ? std::exchange(it->second, std::move(str)) : std::string{};
+    const auto entry = isSet ? it : values.emplace(it, slot, std::move(str));
+    const auto previousSlots = std::exchange(setSlots, setSlots | maskOf(slot));
+    try
+    {
+        expand();
+    }
+    catch (const std::runtime_error &)
+    {
+        // the earlier values were valid
+        if (isSet)
+        {
+            entry->second = std::move(previous);
+        }
+        else
+        {
+            values.erase(entry);
+        }
+        setSlots = previousSlots;
+        throw;
     }
-    configuredArgs.emplace_back(std::move(arg));
     return *this;
 }
 
 inline
-void ArgParser::parse(int argc, char *argv[])
+ArgOverlay &ArgOverlay::reset(const std::string &arg)
 {
-    if (argc < 1 || argv == nullptr)
+    const auto slot = base->configuredSlotOf(arg);
+    const auto it = std::lower_bound(values.begin(), values.end(), slot, [](const auto &entry, auto key)
     {
-        throw std::runtime_error{"Invalid command line arguments"};
+        return entry.first < key;
+    });
+    if (it == values.end() || it->first != slot)
+    {
+        return *this;
     }
+    auto removed = std::move(*it);
+    values.erase(it);
 
-    appPath = argv[0];
-    if (argc == 2 && isHelpString(argv[1]))
+    // other slots might share the bit of @slot
+    const auto previousSlots = std::exchange(setSlots, 0);
+    for (const auto &entry : values)
     {
-        isOnlyHelpString = true;
-        return;
+        setSlots |= maskOf(entry.first);
     }
-
-    for (int i = 1; i < argc; ++i)
+    try
     {
-        const auto argValPair = argValueParser(argv[i]);
-        const auto argOpt = findArg(argValPair.first);
-        if (!argOpt)
-        {
-            throw std::runtime_error(concatenate("Unknown argument: ", argValPair.first.parsedArg));
-        }
-        if (!parsedArgs.emplace(*argOpt, argValPair.second).second)
-        {
-            throw std::runtime_error{concatenate("Received multiple values for: ", argOpt->toString())};
-        }
+        expand();
     }
-    // now add those arguments which have default values
-    for (const auto &arg: configuredArgs)
+    catch (const std::runtime_error &)
     {
-        if (arg.hasDefaultValue())
+        values.insert(std::lower_bound(values.begin(), values.end(), slot, [](const auto &entry, auto key)
         {
-            parsedArgs.emplace(arg, arg.getDefaultValue()); // it won't override if arg already exists
-        }
+            return entry.first < key;
+        }), std::move(removed));
+        setSlots = previousSlots;
+        throw;
     }
-
-    checkMandatoryArgs();
+    return *this;
 }
 
-inline
-std::pair<ArgParser::ParsedArg, std::string> ArgParser::argValueParser(const std::string &arg)
+template<typename T>
+std::optional<T> ArgOverlay::retrieve(const std::string &arg) const
 {
-    static constexpr char SEP{'='};
-    auto pos = arg.find(SEP);
-    if (pos == 0 || pos == std::string::npos)
-    {
-        throw std::runtime_error(concatenate("Separator [", SEP, "] is supposed to separate arg and value in: ", arg));
-    }
-
-    const auto parsedArg{ParsedArg::parse_arg(arg.substr(0, pos))};
-    return std::make_pair(parsedArg, arg.substr(pos + 1));
+    return retrieveSlot<T>(base->slotOf(arg));
 }
 
-inline
-std::optional<ArgParser::Arg> ArgParser::findArg(const ParsedArg &arg) const noexcept
+template<typename T>
+std::optional<T> ArgOverlay::retrieve(ArgParser::Opt<T> opt) const
 {
-    auto argItr = std::find_if(configuredArgs.cbegin(), configuredArgs.cend(),
-                               [&arg](const Arg &eachArg)
-                               { return eachArg.match(arg); });
-    if (argItr != configuredArgs.cend())
+    if (opt.slot() >= base->configuredArgs.size())
     {
-        return *argItr;
+        return std::nullopt;
     }
-    return std::nullopt;
+    return retrieveSlot<T>(opt.slot());
 }
 
 template<typename T>
-std::optional<T> ArgParser::retrieve(const std::string &arg) const
+T ArgOverlay::retrieveMayThrow(const std::string &arg) const
 {
-    validateRetrieval();
-    const auto itr = std::find_if(parsedArgs.cbegin(), parsedArgs.cend(),
-                                  [&arg](const std::pair<Arg, std::string> &argValuePair)
-                                  { return argValuePair.first.match(arg); });
-    if (itr != parsedArgs.cend())
+    const auto retrieved_opt = retrieve<T>(arg);
+    if (retrieved_opt)
     {
-        return from_string<T>(itr->second);
+        return *retrieved_opt;
     }
-    return std::nullopt;
+    throw std::runtime_error{ArgParser::concatenate("Type conversion failed for ", arg)};
 }
 
-template<typename T>
 inline
-std::optional<T> ArgParser::from_string(const std::string &arg) noexcept
+std::size_t ArgOverlay::size() const noexcept
 {
-    if constexpr(std::is_same_v<T, std::string>)
-    {
-        return arg;
-    }
-    else if constexpr(std::is_same_v<T, bool>)
-    {
-        if (arg == truthy) return true;
-        if (arg == falsy)  return false;
-        return std::nullopt;
-    }
-    else if constexpr(std::is_same_v<T, char>)
-    {
-        return (arg.size() == 1) ? std::optional<char>(arg[0]) : std::nullopt;
-    }
-    else if constexpr(std::is_arithmetic_v<std::remove_pointer_t<std::remove_reference_t<T>>>)
-    {
-        T result{};
-        auto end_ptr = arg.c_str() + arg.size();
-        auto[ptr, ec] = std::from_chars(arg.c_str(), end_ptr, result);
-        if (ptr == end_ptr && ec == std::errc{})
-        {
-            return result;
-        }
-    }
-
-    return std::nullopt;
+    return values.size();
 }
 
-inline
-std::string ArgParser::helpMsg() const noexcept
+template<typename T>
+std::optional<T> ArgOverlay::retrieveSlot(std::size_t slot) const
 {
-    std::ostringstream os{};
-
-    if (!getDescription().empty())
+    if (!expanded.empty())
     {
-        os << getDescription() << "\n";
-    }
-
-    os << "Following is a list of configured arguments:\n";
-
-    for (const auto &arg : configuredArgs)
+        if (const auto expansion = findIn(expanded, slot))
+        {
+            return base->convertSlot<T>(slot, *expansion, false);
+        }
+    }
+    if (const auto value = find(slot))
     {
-        os << arg.toVerboseString() << "\n";
+        return base->convertSlot<T>(slot, *value, false);
     }
-    return os.str();
+    return base->retrieveSlot<T>(slot);
 }
 
 inline
-bool ArgParser::isHelpString(const std::string &arg) noexcept
+std::optional<std::string_view> ArgOverlay::find(std::size_t slot) const noexcept
 {
-    static constexpr auto ShortHelpString{"-h"};
-    static constexpr auto LongHelpString{"--help"};
-
-    return arg == ShortHelpString || arg == LongHelpString;
+    if ((setSlots & maskOf(slot)) == 0)
+    {
+        return std::nullopt;
+    }
+    return findIn(values, slot);
 }
 
 inline
-bool ArgParser::needHelp() const noexcept
+std::optional<std::string_view> ArgOverlay::findIn(const std::vector<std::pair<std::size_t, std::string>> &entries,
+                                                   std::size_t slot) noexcept
 {
-    return isOnlyHelpString;
+    const auto it = std::lower_bound(entries.cbegin(), entries.cend(), slot, [](const auto &entry, auto key)
+    {
+        return entry.first < key;
+    });
+    if (it != entries.cend() && it->first == slot)
+    {
+        return it->second;
+    }
+    return std::nullopt;
 }
 
 inline
-ArgParser::ArgParser(std::string description) : description(std::move(description))
+void ArgOverlay::expand()
 {
-    init();
+    if (!base->expansions.enabled)
+    {
+        return;
+    }
+    const auto rawValueOf = [this](std::size_t slot)
+    {
+        const auto value = find(slot);
+        return value ? value : base->rawValue(slot);
+    };
+
+    // only the values which are set, or reference one, differ from the expansions of @base
+    std::vector<std::pair<std::size_t, std::string>> expansions{};
+    for (const auto slot : base->referenceOrder(rawValueOf))
+    {
+        bool isAffected = find(slot).has_value();
+        auto expansion = ArgParser::expand(*rawValueOf(slot), [&](std::string_view name)
+        {
+            // slots are in post order, so the ones referenced are already expanded if they are affected
+            const auto dependency = base->slotOf(std::string{name});
+            const auto it = std::find_if(expansions.cbegin(), expansions.cend(), [dependency](const auto &entry)
+            {
+                return entry.first == dependency;
+            });
+            if (it != expansions.cend())
+            {
+                isAffected = true;
+                return std::optional<std::string_view>{it->second};
+            }
+            if (const auto value = find(dependency))
+            {
+                isAffected = true;
+                return value;
+            }
+            return base->parsedValue(dependency);
+        });
+        if (isAffected)
+        {
+            expansions.emplace_back(slot, std::move(expansion));
+        }
+    }
+    std::sort(expansions.begin(), expansions.end());
+    expanded = std::move(expansions);
 }
 
 inline
-const std::string &ArgParser::getDescription() const noexcept
+std::uint64_t ArgOverlay::maskOf(std::size_t slot) noexcept
 {
-    return description;
+    return std::uint64_t{1} << (slot % 64);
 }
 
-template<typename T>
-T ArgParser::retrieveMayThrow(const std::string &arg) const
+/*
+ * Values which can change while application is running, e.g. log level, read from a config file
+ *      LiveArgs liveArgs{ArgParser{}.addArgumentWithDefault("-l", "--logLevel", "log level", "info"), "app.conf"};
+ *      liveArgs.watch(); // reloads whenever app.conf is modified
+ *      ...
+ *      const auto logLevel = liveArgs.retrieve("logLevel"); // from any thread
+ *
+ * Config file has one argument per line in the command line format e.g. --logLevel=debug
+ * Empty lines and lines starting with '#' are ignored
+ * Each reload parses the file with the rules of passed ArgParser, and if that succeeds, the result is published
+ * as a new immutable snapshot through an atomic pointer, so retrieval never takes a lock or sees a partial update
+ * With interpolation enabled, all the values with references are expanded before the snapshot is published, and
+ * environment variables are read at that time
+ * Readers announce themselves in one of two counters picked by an epoch. A reload which replaced a snapshot flips
+ * the epoch twice, and waits for the counter of each previous epoch to drain before it deletes the old snapshot
+ * */
+class LiveArgs
 {
-    const auto retrieved_opt = retrieve<T>(arg);
-    if (retrieved_opt)
-    {
-        return *retrieved_opt;
-    }
-    throw std::runtime_error{concatenate("Type conversion failed for ", arg)};
-}
+public:
+    // @schema must have all the arguments configured, but must not have been parsed
+    // It will throw exception if the config file can't be read or parsed
+    LiveArgs(ArgParser schema, std::string configPath);
 
-inline
-bool ArgParser::contains(const std::string &arg) const noexcept
-{
-    // although iterating a map is not ideal but not command line arguments are always only few
-    return std::find_if(parsedArgs.cbegin(), parsedArgs.cend(), [&arg](const auto &parsedArg)
+    LiveArgs(const LiveArgs &) = delete;
+    LiveArgs &operator=(const LiveArgs &) = delete;
+
+    ~LiveArgs();
+
+    // Reads and parses the config file, then publishes the values
+    // Reloads from different threads run one after another, so the values of the latest read are published last
+    // It will throw exception if the file can't be read or parsed, previous values stay published in that case
+    void reload();
+
+    // Starts a thread which checks the modification time of config file every @period and reloads on change
+    // Failed reloads keep the previous values, the reason is available through @lastError
+    void watch(std::chrono::milliseconds period = std::chrono::milliseconds{500});
+
+    // Stops the thread started by @watch, if any
+    // It will throw exception if it is called from the watcher thread
+    void stop();
+
+    // Same as ArgParser::retrieve, but lock free and safe to call from any thread
+    template<typename T = std::string>
+    std::optional<T> retrieve(const std::string &arg) const;
+
+    // Same as ArgParser::retrieveMayThrow, but lock free and safe to call from any thread
+    template<typename T = std::string>
+    T retrieveMayThrow(const std::string &arg) const;
+
+    // Same as above, through a handle of an argument of the schema
+    template<typename T>
+    std::optional<T> retrieve(ArgParser::Opt<T> opt) const;
+
+    // Number of published snapshots, starts with 1 after construction
+    std::size_t version() const noexcept;
+
+    // Reason of the last failed reload by the watcher, empty if it succeeded
+    std::string lastError() const;
+
+private:
+    // counts itself as a reader of the current snapshot for its lifetime, so that the snapshot is not deleted
+    class Reader
     {
-        return parsedArg.first.match(arg);
-    }) != parsedArgs.cend();
-}
+    public:
+        explicit Reader(const LiveArgs &liveArgs) noexcept;
+
+        Reader(const Reader &) = delete;
+        Reader &operator=(const Reader &) = delete;
+
+        ~Reader();
+
+        const ArgParser *operator->() const noexcept;
+
+    private:
+        std::atomic<std::size_t> &readers;
+        const ArgParser *snapshot;
+    };
+
+    std::filesystem::file_time_type modificationTime() const noexcept;
+
+    // returns once no reader is left which might have loaded a snapshot replaced before this call
+    void waitForReaders() noexcept;
+
+    ArgParser schema;
+    std::string configPath;
+
+    // the latest snapshot, owned by LiveArgs
+    std::atomic<const ArgParser *> current{nullptr};
+    std::atomic<std::size_t> published{0};
+
+    // readers count themselves in @readers[@epoch % 2]
+    std::atomic<std::size_t> epoch{0};
+    mutable std::array<std::atomic<std::size_t>, 2> readers{};
+
+    // taken for the whole of a reload, before @writerMutex
+    std::mutex reloadMutex{};
+
+    // guards everything below, only writers take it
+    mutable std::mutex writerMutex{};
+    std::filesystem::file_time_type loadedModificationTime{}; // of the config file which was published last
+    std::string watchError{};
+    std::condition_variable stopCondition{};
+    bool stopRequested{false};
+    std::thread watcher{};
+};
 
 inline
-void ArgParser::init() noexcept
+LiveArgs::LiveArgs(ArgParser schema, std::string configPath) :
+        schema(std::move(schema)),
+        configPath(std::move(configPath))
 {
-    // the default help argument
-    Arg helpArg{"-h", "--help", "to get this message"};
-    argKeys.emplace(helpArg.getShortOpt());
-    argKeys.emplace(helpArg.getLongOpt());
-    configuredArgs.emplace_back(std::move(helpArg));
+    // reloads run on other threads, while the application might be reading its config
+    this->schema.bindings.clear();
+    reload();
 }
 
 inline
-ArgParser::ArgParser()
+LiveArgs::~LiveArgs()
 {
-    init();
+    stop();
+    delete current.load(std::memory_order_acquire);
 }
 
 inline
-void ArgParser::validateRetrieval() const
+void LiveArgs::reload()
 {
-    if (appPath.empty())
+    std::lock_guard<std::mutex> reloadLock{reloadMutex};
+    const auto modified = modificationTime(); // before reading, so that a later change is not missed
+    std::ifstream configFile{configPath};
+    if (!configFile)
     {
-        // this means parse() was never called
-        throw std::runtime_error{"parse() must be called with command line arguments before retrieving values"};
+        throw std::runtime_error{ArgParser::concatenate("Couldn't read config file: ", configPath)};
     }
 
-    if (needHelp())
+    std::vector<std::string> args{configPath}; // in place of app path
+    for (std::string line; std::getline(configFile, line);)
     {
-        throw std::runtime_error{"Application was run with '-h' or '--help', retrieving values is not allowed. "
-                                 "Should call @helpMsg and return"};
+        if (!line.empty() && line.back() == '\r')
+        {
+            line.pop_back();
+        }
+        if (!line.empty() && line.front() != '#')
+        {
+            args.emplace_back(std::move(line));
+        }
+    }
+
+    std::vector<char *> argv{};
+    argv.reserve(args.size());
+    std::transform(args.begin(), args.end(), std::back_inserter(argv), [](std::string &arg) { return arg.data(); });
+
+    auto snapshot = std::make_unique<ArgParser>(schema);
+    snapshot->parse(static_cast<int>(argv.size()), argv.data());
+    snapshot->expandReferences(); // the first retrieval of a value with references would lock otherwise
+
+    std::unique_ptr<const ArgParser> replaced{current.exchange(snapshot.release(), std::memory_order_seq_cst)};
+    {
+        std::lock_guard<std::mutex> lock{writerMutex};
+        loadedModificationTime = modified;
+        published.fetch_add(1, std::memory_order_release);
     }
+    waitForReaders(); // then nobody can be using @replaced
 }
 
 inline
-void ArgParser::checkMandatoryArgs() const
+void LiveArgs::watch(std::chrono::milliseconds period)
 {
-    for (const auto &configuredArg : configuredArgs)
+    stop();
+    std::lock_guard<std::mutex> lock{writerMutex};
+    stopRequested = false;
+    watcher = std::thread{[this, period, lastModified = loadedModificationTime]() mutable
     {
-        if (configuredArg.isMandatory())
+        std::unique_lock<std::mutex> watchLock{writerMutex};
+        while (!stopCondition.wait_for(watchLock, period, [this]() { return stopRequested; }))
         {
-            if (parsedArgs.find(configuredArg) == parsedArgs.end())
+            const auto modified = modificationTime();
+            if (modified == lastModified)
             {
-                throw std::runtime_error{concatenate("Couldn't find [", configuredArg.toString(),
-                                                     "] mandatory argument in passed arguments")};
+                continue;
+            }
+            lastModified = modified;
+
+            watchLock.unlock(); // reload takes the lock to publish
+            std::string error{};
+            try
+            {
+                reload();
             }
+            catch (const std::exception &e)
+            {
+                error = e.what();
+            }
+            watchLock.lock();
+            watchError = std::move(error);
         }
-    }
+    }};
 }
 
 inline
-const std::string &ArgParser::getAppPath() const noexcept
+void LiveArgs::stop()
 {
-    return appPath;
+    {
+        std::lock_guard<std::mutex> lock{writerMutex};
+        stopRequested = true;
+    }
+    stopCondition.notify_all();
+    if (watcher.joinable())
+    {
+        watcher.join();
+    }
 }
 
 template<typename T>
-std::string ArgParser::to_string(T &&arg) noexcept
+std::optional<T> LiveArgs::retrieve(const std::string &arg) const
 {
-    // std::decay to remove cv and reference qualifiers
-    if constexpr(std::is_same_v<std::decay_t<T>, std::string>) return arg;
-    else if constexpr(std::is_constructible_v<std::string, std::decay_t<T>>) return std::string{std::forward<T>(arg)};
-    else if constexpr(std::is_same_v<char, std::decay_t<T>>) return {arg};
-    else if constexpr(std::is_same_v<bool, std::decay_t<T>>) return arg ? truthy : falsy;
-    // otherwise all we support is arithmetic values, let std::to_string take care of issues
-    else return std::to_string(std::forward<T>(arg)); // wow! this was fun! without else, return fails to compile!
+    return Reader{*this}->retrieve<T>(arg);
 }
 
-template<typename ...Ts>
-std::string ArgParser::concatenate(Ts &&...args) noexcept
+template<typename T>
+T LiveArgs::retrieveMayThrow(const std::string &arg) const
 {
-    // This is inefficient compared to fmt::format, but we need to keep this header only library
-    // and btw, this happens only in error cases
-    return (ArgParser::to_string(std::forward<Ts>(args)) + ...);
+    return Reader{*this}->retrieveMayThrow<T>(arg);
 }
 
-inline
-ArgParser::Arg::Arg(const std::string &shortArg, const std::string &longArg, std::string helpMsg, bool isMandatory) :
-        helpMsg(std::move(helpMsg)),
-        hasDefault(false),
-        mandatory(isMandatory)
+template<typename T>
+std::optional<T> LiveArgs::retrieve(ArgParser::Opt<T> opt) const
 {
-    init_args(shortArg, longArg);
+    return Reader{*this}->retrieve(opt);
 }
 
 inline
-ArgParser::Arg::Arg(const std::string &shortArg, const std::string &longArg, std::string helpMsg,
-                    std::string defaultValue) :
-        helpMsg(std::move(helpMsg)),
-        defaultValue(std::move(defaultValue)),
-        hasDefault(true)
+std::size_t LiveArgs::version() const noexcept
 {
-    init_args(shortArg, longArg);
+    return published.load(std::memory_order_acquire);
 }
 
 inline
-bool ArgParser::Arg::operator==(const Arg &rhs) const noexcept
+std::string LiveArgs::lastError() const
 {
-    return shortOpt == rhs.shortOpt && longOpt == rhs.longOpt;
+    std::lock_guard<std::mutex> lock{writerMutex};
+    return watchError;
 }
 
 inline
-bool ArgParser::Arg::operator!=(const Arg &rhs) const noexcept
+std::filesystem::file_time_type LiveArgs::modificationTime() const noexcept
 {
-    return !(*this == rhs);
+    std::error_code ec{};
+    return std::filesystem::last_write_time(configPath, ec); // a missing file is reported by reload
 }
 
 inline
-bool ArgParser::Arg::operator<(const Arg &rhs) const noexcept
+void LiveArgs::waitForReaders() noexcept
 {
-    return std::tie(shortOpt, longOpt) < std::tie(rhs.shortOpt, rhs.longOpt);
+    // a reader might have loaded the epoch before one flip, but counted itself only after it, so that it waits
+    // behind the second flip
+    for (int flip = 0; flip < 2; ++flip)
+    {
+        const auto previous = epoch.fetch_add(1, std::memory_order_seq_cst);
+        while (readers[previous % 2].load(std::memory_order_seq_cst) != 0)
+        {
+            std::this_thread::yield();
+        }
+    }
 }
 
 inline
-const std::string &ArgParser::Arg::getShortOpt() const noexcept
+LiveArgs::Reader::Reader(const LiveArgs &liveArgs) noexcept :
+        readers(liveArgs.readers[liveArgs.epoch.load(std::memory_order_seq_cst) % 2])
 {
-    return shortOpt;
+    readers.fetch_add(1, std::memory_order_seq_cst);
+    snapshot = liveArgs.current.load(std::memory_order_seq_cst);
 }
 
 inline
-const std::string &ArgParser::Arg::getLongOpt() const noexcept
+LiveArgs::Reader::~Reader()
 {
-    return longOpt;
+    readers.fetch_sub(1, std::memory_order_release);
 }
 
 inline
-bool ArgParser::Arg::match(const ParsedArg &arg) const
+const ArgParser *LiveArgs::Reader::operator->() const noexcept
 {
-    switch (arg.argType)
-    {
-        case ArgTypeEnum::Short:
-            return arg.parsedArg == this->shortOpt;
-
-        case ArgTypeEnum::Long:
-            return arg.parsedArg == this->longOpt;
-
-        case ArgTypeEnum::Invalid:
-            throw std::runtime_error{concatenate("Attempting to match with Invalid argument")};
-    }
-    return false; // just to make compiler happy
+    return snapshot;
 }
 
-inline
-bool ArgParser::Arg::match(const std::string &arg) const noexcept
+/*
+ * A flag defined next to the code which uses it, registered in ArgParser::flags() before main e.g.
+ *      // batcher.cpp
+ *      ARG_PARSER_FLAG(int, b, batch_size, 32, "items per batch");
+ *      ... if (items.size() >= *FLAGS_batch_size) ...
+ *
+ *      // other.cpp, to use it in another translation unit
+ *      ARG_PARSER_DECLARE_FLAG(int, batch_size);
+ *
+ *      // main.cpp
+ *      ArgParser::parseFlags(argc, argv); // then --batch_size=64 or -b=64 sets it
+ *
+ * Reading a flag is an acquire load of a pointer, without any lookup or lock, so it is fine on hot paths and
+ * from any thread. It points to the default value till ArgParser::parseFlags publishes the parsed one with a
+ * release store, once, and the value doesn't change after that
+ * Flags must have static storage duration, and must not be read by static initializers of other translation
+ * units, as they might not be constructed yet
+ * A flag which can't be registered, e.g. a duplicate, makes ArgParser::parseFlags throw
+ * */
+template<typename T>
+class ArgFlag
 {
-    return arg == shortOpt || arg == longOpt;
-}
+public:
+    // Same arguments as ArgParser::addArgumentWithDefault
+    ArgFlag(const std::string &shortOpt, const std::string &longOpt, const std::string &helpMsg, T defaultValue);
 
-inline
-std::string ArgParser::Arg::toString() const noexcept
+    ArgFlag(const ArgFlag &) = delete;
+    ArgFlag &operator=(const ArgFlag &) = delete;
+
+    const T &operator*() const noexcept;
+
+    const T *operator->() const noexcept;
+
+private:
+    friend class ArgParser;
+
+    const T defaultValue;
+    T parsedValue;
+    std::atomic<const T *> current;
+};
+
+// Defines FLAGS_<longName> of @type, e.g. ARG_PARSER_FLAG(int, b, batch_size, 32, "items per batch")
+#define ARG_PARSER_FLAG(type, shortName, longName, defaultValue, helpMsg) \
+    ArgFlag<type> FLAGS_##longName{"-" #shortName, "--" #longName, helpMsg, defaultValue}
+
+// Declares FLAGS_<longName> which is defined by ARG_PARSER_FLAG in another translation unit
+#define ARG_PARSER_DECLARE_FLAG(type, longName) extern ArgFlag<type> FLAGS_##longName
+
+template<typename T>
+ArgFlag<T>::ArgFlag(const std::string &shortOpt, const std::string &longOpt, const std::string &helpMsg,
+                    T defaultValue) :
+        defaultValue(defaultValue),
+        parsedValue(std::move(defaultValue)),
+        current(&this->defaultValue)
 {
-    return concatenate('-', shortOpt, ", --", longOpt);
+    ArgParser::registerFlag(*this, shortOpt, longOpt, helpMsg);
 }
 
-inline
-bool ArgParser::Arg::hasDefaultValue() const noexcept
+template<typename T>
+const T &ArgFlag<T>::operator*() const noexcept
 {
-    return hasDefault;
+    return *current.load(std::memory_order_acquire);
 }
 
-inline
-const std::string &ArgParser::Arg::getDefaultValue() const
+template<typename T>
+const T *ArgFlag<T>::operator->() const noexcept
 {
-    if (hasDefaultValue())
-    {
-        return defaultValue;
-    }
-    throw std::runtime_error{concatenate("There was no default set for: ", toString())};
+    return current.load(std::memory_order_acquire);
 }
 
-inline
-void ArgParser::Arg::init_args(const std::string &shortArg, const std::string &longArg)
+/*
+ * Validates command lines with the schema exported by ArgParser::schemaJson(), without running the application
+ * e.g. an orchestrator checking the arguments of a job before scheduling it
+ *      ArgValidator validator{schemaJson};
+ *      if (const auto error = validator.validate({"app", "--logfile=app.log"}))
+ *      {
+ *          reject(*error); // same message as parse() would throw
+ *      }
+ *
+ * It parses with an ArgParser configured from the schema, so the rules are the same as of parse(), except that
+ * values are not converted, as the schema has no types, e.g. --waitTime=abc passes even if the application binds
+ * it to an int member, and its parse() throws for it
+ * References of interpolated values are checked as by parse(), unknown arguments, cycles and the size limit
+ * Values are not stored, and it takes microseconds instead of starting a process
+ * */
+class ArgValidator
 {
-    // @shortArg and @longArg are only being forwarded till ParsedArg::parse_arg
-    // hence, it is better to accept them as reference to const std::string instead of keep moving
-    const auto shortParsedArg = ParsedArg::parse_arg(shortArg);
-    const auto longParsedArg = ParsedArg::parse_arg(longArg);
-
-    if (shortParsedArg.argType != ArgTypeEnum::Short)
-    {
-        throw std::runtime_error{concatenate("Invalid short option: ", shortArg)};
-    }
-
-    if (longParsedArg.argType != ArgTypeEnum::Long)
-    {
-        throw std::runtime_error{concatenate("Invalid long option: ", longArg)};
-    }
+public:
+    // It will throw exception for the same reasons as ArgParser::fromSchemaJson
+    explicit ArgValidator(std::string_view schemaJson);
 
-    // both can't be same parsed arguments
-    if (shortParsedArg.parsedArg.size() >= longParsedArg.parsedArg.size())
-    {
-        throw std::runtime_error{
-                concatenate("Short option [", shortArg, "] must be shorter than Long option [", longArg, ']')};
-    }
-    shortOpt = shortParsedArg.parsedArg;
-    longOpt = longParsedArg.parsedArg;
-}
+    // Returns what parse() would throw for these command line arguments, std::nullopt if it wouldn't throw,
+    // except for values which can't be converted to bound members
+    // As in main function, first argument is the application path
+    std::optional<std::string> validate(int argc, char *argv[]);
 
-inline
-std::string ArgParser::Arg::toVerboseString() const noexcept
-{
-    if (hasDefaultValue())
-    {
-        return concatenate(toString(), "\n\tdescription: ", helpMsg, ", default: ", getDefaultValue());
-    }
+    // Same as above, with command line arguments as strings
+    std::optional<std::string> validate(const std::vector<std::string> &args);
 
-    if (isMandatory())
-    {
-        return concatenate(toString(), "\n\tdescription: ", helpMsg, ", mandatory: ",
-                           isMandatory() ? "true" : "false");
-    }
+    // Description of the application in the schema
+    const std::string &getDescription() const noexcept;
 
-    return concatenate(toString(), "\n\tdescription: ", helpMsg);
-}
+private:
+    ArgParser schema;
+};
 
 inline
-bool ArgParser::Arg::isMandatory() const noexcept
-{
-    return mandatory;
-}
+ArgValidator::ArgValidator(std::string_view schemaJson) : schema(ArgParser::fromSchemaJson(schemaJson))
+{}
 
 inline
-ArgParser::ParsedArg ArgParser::ParsedArg::parse_arg(const std::string &arg)
+std::optional<std::string> ArgValidator::validate(int argc, char *argv[])
 {
-    static constexpr char us = '_';
-
-    const auto pos = arg.find_first_not_of('-');
-    if (pos == 0 || pos == std::string::npos)
+    try
     {
-        return ParsedArg{ArgTypeEnum::Invalid, arg};
-    }
+        if (!schema.expansions.enabled)
+        {
+            schema.parse(argc, argv, [](std::size_t, std::string_view) {});
+            return std::nullopt;
+        }
 
-    if (!std::all_of(std::next(arg.cbegin(), static_cast<long>(pos)), arg.cend(),
-                     [](unsigned char c) { return std::isalnum(c) || c == us; }))
-    {
-        return ParsedArg{ArgTypeEnum::Invalid, arg};
+        // values are views into @argv and @schema, these are checked the same as parse() checks the stored ones
+        std::vector<std::optional<std::string_view>> values(schema.configuredArgs.size());
+        schema.parse(argc, argv, [&values](std::size_t slot, std::string_view value) { values[slot] = value; });
+        schema.referenceOrder([&values](std::size_t slot) { return values[slot]; });
     }
-
-    if (pos == 1)
+    catch (const std::runtime_error &e)
     {
-        return ParsedArg{ArgTypeEnum::Short, arg.substr(pos)};
+        return e.what();
     }
+    return std::nullopt;
+}
 
-    if (pos == 2)
+inline
+std::optional<std::string> ArgValidator::validate(const std::vector<std::string> &args)
+{
+    // parse() doesn't modify arguments
+    std::vector<char *> argv{};
+    argv.reserve(args.size() + 1);
+    for (const auto &arg : args)
     {
-        return ParsedArg{ArgTypeEnum::Long, arg.substr(pos)};
+        argv.push_back(const_cast<char *>(arg.c_str()));
     }
+    argv.push_back(nullptr);
+    return validate(static_cast<int>(args.size()), argv.data());
+}
 
-    return ParsedArg{ArgTypeEnum::Invalid, arg};
-}
\ No newline at end of file
+inline
+const std::string &ArgValidator::getDescription() const noexcept
+{
+    return schema.getDescription();
+}
@@ -1,6 +1,12 @@
 #include <argParser/ArgParser.h>
 #include <gtest/gtest.h>
 #include "../TestUtil.h"
+#include <sstream>
+#include <fstream>
+#include <filesystem>
+#include <thread>
+#include <random>
+#include <cmath>
 
 struct ArgParserTest : public ::testing::Test
 {
@@ -12,6 +18,19 @@ struct ArgParserTest : public ::testing::Test
     std::string logFilePathShortOption{concatenate(logFileShortOption, '=', logFilePath)};
     std::string logFilePathLongOption{concatenate(logFileLongOption, '=', logFilePath)};
 
+    // parses @args as the command line, after the binary path
+    ArgParser &parse(ArgParser &argParser, std::vector<std::string> args)
+    {
+        args.insert(args.begin(), binaryPath);
+        std::vector<char *> argv{};
+        for (auto &arg : args)
+        {
+            argv.push_back(arg.data());
+        }
+        argParser.parse(static_cast<int>(argv.size()), argv.data());
+        return argParser;
+    }
+
     template <typename T>
     std::string to_string(T&& arg) noexcept
     {
@@ -553,4 +572,1448 @@ TEST_F(ArgParserTest, ValidArgsTest)
     {
         EXPECT_TRUE(false);  // because this should not be executed
     }
-}
\ No newline at end of file
+}
+
+TEST_F(ArgParserTest, StreamParseTest)
+{
+    ArgParser argParser{};
+    argParser.addArgument(logFileShortOption, logFileLongOption, logFileHelpMessage);
+    argParser.addArgument("-c", "--counter", "to get the counter");
+
+    const char rawInput[] = "--counter=10\0/tmp/a\0\0-l=/tmp/log\0-c=12\0/tmp/b";
+    std::istringstream input{std::string{rawInput, sizeof(rawInput) - 1}};
+    std::vector<std::pair<std::size_t, std::string>> items{};
+    argParser.parse(input, [&items](std::size_t slot, std::string_view value)
+    {
+        items.emplace_back(slot, std::string{value});
+    }, '\0');
+
+    const auto counterSlot = argParser.slotOf("counter");
+    const auto logSlot = argParser.slotOf("logFilePath");
+    ASSERT_EQ(counterSlot, argParser.slotOf("c"));
+    ASSERT_EQ(logSlot, argParser.slotOf("l"));
+    EXPECT_EQ(argParser.slotOf("unknown"), ArgParser::npos);
+
+    const std::vector<std::pair<std::size_t, std::string>> expected{
+            {counterSlot,    "10"},
+            {ArgParser::npos, "/tmp/a"},
+            {logSlot,        "/tmp/log"},
+            {counterSlot,    "12"},
+            {ArgParser::npos, "/tmp/b"}};
+    EXPECT_EQ(items, expected);
+}
+
+TEST_F(ArgParserTest, StreamParseLongItemsTest)
+{
+    // items spanning more than one read of the internal buffer
+    ArgParser argParser{};
+    argParser.addArgument("-c", "--counter", "to get the counter");
+
+    const std::string longItem(10000, 'x');
+    std::istringstream input{concatenate(longItem, '\n', "-c=", longItem, '\n', longItem)};
+    std::size_t count{0};
+    argParser.parse(input, [&](std::size_t slot, std::string_view value)
+    {
+        EXPECT_EQ(slot, count == 1 ? argParser.slotOf("c") : ArgParser::npos);
+        EXPECT_EQ(value, longItem);
+        ++count;
+    });
+    EXPECT_EQ(count, 3);
+}
+
+TEST_F(ArgParserTest, StreamParseBadItemTest)
+{
+    ArgParser argParser{};
+    argParser.addArgument("-c", "--counter", "to get the counter");
+
+    std::istringstream unknownInput{"-c=1\n--waitTime=2\n"};
+    EXPECT_EXCEPTION(argParser.parse(unknownInput, [](std::size_t, std::string_view) {}),
+                     std::runtime_error, "Unknown argument: waitTime");
+
+    std::istringstream badInput{"-c\n"};
+    EXPECT_EXCEPTION(argParser.parse(badInput, [](std::size_t, std::string_view) {}),
+                     std::runtime_error, "Separator [=] is supposed to separate arg and value in: -c");
+}
+
+TEST_F(ArgParserTest, VisitorParseTest)
+{
+    ArgParser argParser{};
+    argParser.addArgument(logFileShortOption, logFileLongOption, logFileHelpMessage, true);
+    argParser.addArgumentWithDefault("-c", "--counter", "to get the counter", 10);
+    argParser.addArgumentWithDefault("-w", "--waitTime", "to get the wait time", 5);
+    argParser.addArgument("-n", "--number", "to get the number");
+
+    std::string waitArg{"-w=12"};
+    char *argv[] = {binaryPath.data(), logFilePathLongOption.data(), waitArg.data()};
+
+    std::vector<std::pair<std::size_t, std::string>> visited{};
+    argParser.parse(3, argv, [&visited](std::size_t slot, std::string_view value)
+    {
+        visited.emplace_back(slot, std::string{value});
+    });
+
+    // passed arguments in the order of argv, then the defaults
+    const std::vector<std::pair<std::size_t, std::string>> expected{
+            {argParser.slotOf("l"), logFilePath},
+            {argParser.slotOf("w"), "12"},
+            {argParser.slotOf("c"), "10"}};
+    EXPECT_EQ(visited, expected);
+
+    // nothing was stored
+    EXPECT_FALSE(argParser.contains("l"));
+    EXPECT_FALSE(argParser.retrieve("w"));
+}
+
+TEST_F(ArgParserTest, VisitorParseErrorsTest)
+{
+    ArgParser argParser{};
+    argParser.addArgument(logFileShortOption, logFileLongOption, logFileHelpMessage, true);
+    argParser.addArgument("-c", "--counter", "to get the counter");
+    const auto ignore = [](std::size_t, std::string_view) {};
+
+    std::string counterArg{"-c=10"};
+    std::string repeatedCounterArg{"--counter=11"};
+    char *repeatedArgv[] = {binaryPath.data(), counterArg.data(), repeatedCounterArg.data()};
+    EXPECT_EXCEPTION(argParser.parse(3, repeatedArgv, ignore), std::runtime_error,
+                     "Received multiple values for: -c, --counter");
+
+    char *missingArgv[] = {binaryPath.data(), counterArg.data()};
+    EXPECT_EXCEPTION(argParser.parse(2, missingArgv, ignore), std::runtime_error,
+                     "Couldn't find [-l, --logFilePath] mandatory argument in passed arguments");
+
+    std::string helpArg{"--help"};
+    char *helpArgv[] = {binaryPath.data(), helpArg.data()};
+    argParser.parse(2, helpArgv, [](std::size_t, std::string_view) { FAIL() << "must not be visited"; });
+    EXPECT_TRUE(argParser.needHelp());
+}
+
+TEST_F(ArgParserTest, SnapshotTest)
+{
+    ArgParser argParser{};
+    argParser.addArgument(logFileShortOption, logFileLongOption, logFileHelpMessage);
+    argParser.addArgumentWithDefault("-c", "--counter", "to get the counter", 10);
+    argParser.addArgumentWithDefault("-e", "--enable", "to enable", false);
+    argParser.addArgument("-w", "--waitTime", "to get the wait time");
+    argParser.addChoiceArgument("-s", "--speed", "speed",
+                                std::vector<std::pair<std::string, long>>{{"slow", -5}, {"fast", 5}});
+    argParser.addChoiceArgumentWithDefault("-v", "--level", "log level",
+                                           std::vector<std::pair<std::string, int>>{{"debug", 10}, {"info", 20}},
+                                           "info");
+    argParser.addArgumentWithDefault("-i", "--ids", "to get the ids", "1;-2;30");
+    argParser.setListDelimiter(';');
+    std::string enableArg{"--enable=true"};
+    std::string speedArg{"--speed=slow"};
+    char *argv[] = {binaryPath.data(), logFilePathShortOption.data(), enableArg.data(), speedArg.data()};
+    argParser.parse(4, argv);
+
+    const auto blob = argParser.snapshot();
+    const ArgSnapshot snapshot{blob};
+    EXPECT_EQ(snapshot.getAppPath(), binaryPath);
+    EXPECT_EQ(snapshot.retrieve("l"), logFilePath);
+    EXPECT_EQ(snapshot.retrieve("logFilePath"), logFilePath);
+    EXPECT_EQ(snapshot.retrieve<int>("counter"), 10); // the default one
+    EXPECT_EQ(snapshot.retrieve<bool>("e"), true);
+    EXPECT_FALSE(snapshot.retrieve<int>("l"));
+    EXPECT_FALSE(snapshot.retrieve("waitTime"));
+    EXPECT_FALSE(snapshot.contains("w"));
+    EXPECT_TRUE(snapshot.contains("c"));
+    EXPECT_EQ(snapshot.retrieveMayThrow<int>("c"), 10);
+    EXPECT_EXCEPTION(snapshot.retrieveMayThrow<int>("waitTime"), std::runtime_error,
+                     "Type conversion failed for waitTime");
+
+    // choices have their mapped values, same as in argParser
+    EXPECT_EQ(snapshot.retrieve<long>("speed"), -5);
+    EXPECT_EQ(snapshot.retrieve("speed"), "slow");
+    EXPECT_EQ(snapshot.retrieve<int>("level"), 20); // the default one
+    EXPECT_EQ(snapshot.retrieve<std::int64_t>("v"), argParser.retrieve<std::int64_t>("v"));
+    EXPECT_EQ(snapshot.retrieve("level"), "info");
+
+    // lists are split by the delimiter of argParser
+    EXPECT_EQ(snapshot.retrieve<std::vector<int>>("ids"), (std::vector<int>{1, -2, 30}));
+    EXPECT_EQ(snapshot.retrieve<std::vector<std::string>>("i"), (std::vector<std::string>{"1", "-2", "30"}));
+    EXPECT_EQ(snapshot.retrieve<std::vector<int>>("logFilePath"), std::nullopt);
+}
+
+TEST_F(ArgParserTest, BadSnapshotTest)
+{
+    ArgParser argParser{};
+    EXPECT_EXCEPTION(argParser.snapshot(), std::runtime_error,
+                     "parse() must be called with command line arguments before retrieving values");
+
+    argParser.addArgument(logFileShortOption, logFileLongOption, logFileHelpMessage);
+    char *argv[] = {binaryPath.data(), logFilePathShortOption.data()};
+    argParser.parse(2, argv);
+    auto blob = argParser.snapshot();
+
+    EXPECT_EXCEPTION(ArgSnapshot{"ARG"}, std::runtime_error, "Invalid snapshot of parsed arguments");
+    EXPECT_EXCEPTION(ArgSnapshot{std::string_view{blob}.substr(0, blob.size() - 1)}, std::runtime_error,
+                     "Truncated snapshot of parsed arguments");
+    EXPECT_EXCEPTION(ArgSnapshot{std::string_view{blob}.substr(0, 30)}, std::runtime_error,
+                     "Truncated snapshot of parsed arguments");
+
+    blob[4] = 9;
+    EXPECT_EXCEPTION(ArgSnapshot{blob}, std::runtime_error, "Unsupported snapshot version: 9");
+}
+
+struct LiveArgsTest : public ArgParserTest
+{
+    std::string configPath{(std::filesystem::temp_directory_path() /
+                            concatenate("LiveArgsTest_", ::testing::UnitTest::GetInstance()->random_seed(), "_",
+                                        reinterpret_cast<std::uintptr_t>(this), ".conf")).string()};
+
+    ArgParser schema = ArgParser{}
+            .addArgumentWithDefault("-l", "--logLevel", "log level", "info")
+            .addArgument("-r", "--rateLimit", "rate limit", true);
+
+    void writeConfig(const std::string &content)
+    {
+        std::ofstream{configPath} << content;
+    }
+
+    ~LiveArgsTest() override
+    {
+        std::filesystem::remove(configPath);
+    }
+};
+
+TEST_F(LiveArgsTest, ReloadTest)
+{
+    writeConfig("# rate limit per second\n--rateLimit=100\n\n");
+    LiveArgs liveArgs{schema, configPath};
+    EXPECT_EQ(liveArgs.version(), 1);
+    EXPECT_EQ(liveArgs.retrieve("logLevel"), "info");
+    EXPECT_EQ(liveArgs.retrieve<int>("r"), 100);
+
+    writeConfig("-l=debug\r\n-r=200\n");
+    liveArgs.reload();
+    EXPECT_EQ(liveArgs.version(), 2);
+    EXPECT_EQ(liveArgs.retrieve("logLevel"), "debug");
+    EXPECT_EQ(liveArgs.retrieveMayThrow<int>("rateLimit"), 200);
+    EXPECT_EQ(liveArgs.retrieve(schema.optOf<int>("rateLimit")), 200);
+
+    // invalid changes are not published
+    writeConfig("-l=warn\n");
+    EXPECT_EXCEPTION(liveArgs.reload(), std::runtime_error,
+                     "Couldn't find [-r, --rateLimit] mandatory argument in passed arguments");
+    EXPECT_EQ(liveArgs.version(), 2);
+    EXPECT_EQ(liveArgs.retrieve("logLevel"), "debug");
+}
+
+TEST_F(LiveArgsTest, InterpolationTest)
+{
+    writeConfig("-r=100\n-l=rate-${r}\n");
+    LiveArgs liveArgs{ArgParser{schema}.enableInterpolation(), configPath};
+    EXPECT_EQ(liveArgs.retrieve("logLevel"), "rate-100"); // expanded before the snapshot is published
+}
+
+TEST_F(LiveArgsTest, MissingConfigTest)
+{
+    EXPECT_EXCEPTION((LiveArgs{schema, configPath}), std::runtime_error,
+                     concatenate("Couldn't read config file: ", configPath));
+}
+
+TEST_F(LiveArgsTest, ReloadWhileReadingTest)
+{
+    writeConfig("-r=0\n");
+    LiveArgs liveArgs{schema, configPath};
+
+    std::atomic<bool> done{false};
+    std::vector<std::thread> readers{};
+    for (int i = 0; i < 2; ++i)
+    {
+        readers.emplace_back([&liveArgs, &done]()
+        {
+            while (!done)
+            {
+                const auto rateLimit = liveArgs.retrieve<int>("r");
+                ASSERT_TRUE(rateLimit && *rateLimit >= 0 && *rateLimit < 50);
+            }
+        });
+    }
+
+    // replaced snapshots are deleted while readers keep reading, which the address sanitizer checks
+    for (int i = 1; i < 50; ++i)
+    {
+        writeConfig(concatenate("-r=", i, "\n"));
+        liveArgs.reload();
+    }
+    done = true;
+    for (auto &reader : readers)
+    {
+        reader.join();
+    }
+    EXPECT_EQ(liveArgs.version(), 50);
+    EXPECT_EQ(liveArgs.retrieve<int>("rateLimit"), 49);
+}
+
+TEST_F(LiveArgsTest, WatchTest)
+{
+    writeConfig("-r=1\n");
+    LiveArgs liveArgs{schema, configPath};
+    liveArgs.watch(std::chrono::milliseconds{5});
+
+    std::atomic<bool> done{false};
+    std::vector<std::thread> readers{};
+    for (int i = 0; i < 4; ++i)
+    {
+        readers.emplace_back([&liveArgs, &done]()
+        {
+            while (!done)
+            {
+                const auto rateLimit = liveArgs.retrieve<int>("r");
+                ASSERT_TRUE(rateLimit && (*rateLimit == 1 || *rateLimit == 2));
+            }
+        });
+    }
+
+    const auto waitForVersion = [&liveArgs](std::size_t version)
+    {
+        for (int i = 0; i < 400 && liveArgs.version() < version; ++i)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds{5});
+        }
+        return liveArgs.version() >= version;
+    };
+
+    writeConfig("-r=2\n");
+    std::filesystem::last_write_time(configPath, std::filesystem::last_write_time(configPath) + std::chrono::hours{1});
+    EXPECT_TRUE(waitForVersion(2));
+    EXPECT_EQ(liveArgs.retrieve<int>("rateLimit"), 2);
+    EXPECT_TRUE(liveArgs.lastError().empty());
+
+    writeConfig("-r=3\n-r=4\n");
+    std::filesystem::last_write_time(configPath, std::filesystem::last_write_time(configPath) + std::chrono::hours{2});
+    for (int i = 0; i < 400 && liveArgs.lastError().empty(); ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds{5});
+    }
+    EXPECT_EQ(liveArgs.lastError(), "Received multiple values for: -r, --rateLimit");
+    EXPECT_EQ(liveArgs.retrieve<int>("rateLimit"), 2);
+
+    done = true;
+    for (auto &reader : readers)
+    {
+        reader.join();
+    }
+    liveArgs.stop();
+}
+
+TEST_F(ArgParserTest, CompletionTest)
+{
+    ArgParser argParser{};
+    argParser.addArgument("-l", "--logfile", "logfile path");
+    argParser.addArgumentWithDefault("-c", "--counter", "to get the counter", 15);
+    argParser.addArgument("-lc", "--logCount", "log count");
+
+    std::string completeArg{"--complete"};
+    std::string prefix{"--lo"};
+    char *argv[] = {binaryPath.data(), completeArg.data(), prefix.data()};
+    argParser.parse(3, argv);
+
+    EXPECT_TRUE(argParser.needCompletion());
+    EXPECT_FALSE(argParser.needHelp());
+    EXPECT_EQ(argParser.completionMsg(), "--logCount=\n--logfile=\n");
+    EXPECT_EXCEPTION(argParser.retrieve("l"), std::runtime_error,
+                     "Application was run with '--complete', retrieving values is not allowed. "
+                     "Should call @completionMsg and return");
+
+    ArgParser allArgParser{argParser};
+    std::string dash{"-"};
+    char *allArgv[] = {binaryPath.data(), completeArg.data(), dash.data()};
+    allArgParser.parse(3, allArgv);
+    EXPECT_EQ(allArgParser.completionMsg(), "--counter=\n--help\n--logCount=\n--logfile=\n-c=\n-h\n-l=\n-lc=\n");
+}
+
+TEST_F(ArgParserTest, CompletionNotRequestedTest)
+{
+    ArgParser argParser{};
+    char *argv[] = {binaryPath.data()};
+    argParser.parse(1, argv);
+    EXPECT_FALSE(argParser.needCompletion());
+    EXPECT_EXCEPTION(argParser.completionMsg(), std::runtime_error, "Application was not run with '--complete'");
+}
+
+TEST_F(ArgParserTest, CompletionScriptTest)
+{
+    ArgParser argParser{};
+    argParser.addArgument("-l", "--logfile", "logfile path");
+
+    EXPECT_EQ(argParser.completionScript(ArgParser::Shell::Bash, "my-app"),
+              "# bash completion for my-app\n"
+              "_my_app_complete()\n{\n"
+              "    COMPREPLY=($(compgen -W \"--help --logfile= -h -l=\" -- \"${COMP_WORDS[COMP_CWORD]}\"))\n}\n"
+              "complete -o nospace -F _my_app_complete my-app\n");
+
+    EXPECT_EQ(argParser.completionScript(ArgParser::Shell::Zsh, "app"),
+              "#compdef app\n"
+              "_app_complete()\n{\n"
+              "    compadd -S '' -- --help --logfile= -h -l=\n}\n"
+              "compdef _app_complete app\n");
+
+    EXPECT_EQ(argParser.completionScript(ArgParser::Shell::Fish, "app"),
+              "# fish completion for app\n"
+              "complete -c app -f -a '--help --logfile= -h -l='\n");
+
+    EXPECT_EQ(argParser.completionScript(ArgParser::Shell::Fish, "app.v2"),
+              "# fish completion for app.v2\n"
+              "complete -c app.v2 -f -a '--help --logfile= -h -l='\n");
+    EXPECT_EXCEPTION(argParser.completionScript(ArgParser::Shell::Bash, "app; rm -rf ~"), std::runtime_error,
+                     "Invalid application name [app; rm -rf ~] for completion, it must only consist of alphanumeric "
+                     "characters, '_', '.' and '-'");
+    EXPECT_EXCEPTION(argParser.completionScript(ArgParser::Shell::Zsh, ""), std::runtime_error,
+                     "Invalid application name [] for completion, it must only consist of alphanumeric "
+                     "characters, '_', '.' and '-'");
+}
+
+TEST_F(ArgParserTest, MutuallyExclusiveTest)
+{
+    ArgParser argParser{};
+    argParser.addArgument("-j", "--json", "json output");
+    argParser.addArgument("-x", "--xml", "xml output");
+    argParser.addArgument("-y", "--yaml", "yaml output");
+    argParser.addArgument("-v", "--verbose", "verbosity");
+    argParser.addMutuallyExclusive({"json", "x", "yaml"});
+
+    std::string jsonArg{"-j=1"}, xmlArg{"-x=1"}, yamlArg{"--yaml=1"}, verboseArg{"-v=1"};
+    char *goodArgv[] = {binaryPath.data(), jsonArg.data(), verboseArg.data()};
+    ArgParser{argParser}.parse(3, goodArgv);
+
+    char *badArgv[] = {binaryPath.data(), yamlArg.data(), verboseArg.data(), jsonArg.data()};
+    EXPECT_EXCEPTION(ArgParser{argParser}.parse(4, badArgv), std::runtime_error,
+                     "Mutually exclusive arguments can't be passed together: [-j, --json], [-y, --yaml]");
+}
+
+TEST_F(ArgParserTest, AtLeastOneAndRequiresTest)
+{
+    ArgParser argParser{};
+    argParser.addArgument("-i", "--input", "input file");
+    argParser.addArgument("-s", "--stdin", "read from stdin");
+    argParser.addArgument("-u", "--user", "user name");
+    argParser.addArgument("-p", "--password", "password");
+    argParser.addAtLeastOne({"input", "stdin"});
+    argParser.addRequires("password", "u");
+
+    std::string inputArg{"-i=a.txt"}, userArg{"-u=me"}, passwordArg{"-p=secret"};
+    char *noInputArgv[] = {binaryPath.data(), userArg.data()};
+    EXPECT_EXCEPTION(ArgParser{argParser}.parse(2, noInputArgv), std::runtime_error,
+                     "At least one of these arguments must be passed: [-i, --input], [-s, --stdin]");
+
+    char *noUserArgv[] = {binaryPath.data(), inputArg.data(), passwordArg.data()};
+    EXPECT_EXCEPTION(ArgParser{argParser}.parse(3, noUserArgv), std::runtime_error,
+                     "[-p, --password] requires [-u, --user] to be passed as well");
+
+    char *goodArgv[] = {binaryPath.data(), inputArg.data(), passwordArg.data(), userArg.data()};
+    argParser.parse(4, goodArgv);
+    EXPECT_EQ(argParser.retrieve("user"), "me");
+}
+
+TEST_F(ArgParserTest, ConstraintsOverManyArgsTest)
+{
+    // slots spread over more than one word of the masks
+    ArgParser argParser{};
+    for (int i = 0; i < 200; ++i)
+    {
+        argParser.addArgument(concatenate("-a", i), concatenate("--arg", i), "", i == 150);
+    }
+    argParser.addMutuallyExclusive({"arg190", "arg10", "arg100"});
+    argParser.addRequires("arg5", "arg199");
+
+    std::string arg150{"-a150=1"}, arg10{"-a10=1"}, arg190{"--arg190=1"}, arg5{"-a5=1"};
+    char *missingArgv[] = {binaryPath.data(), arg10.data()};
+    EXPECT_EXCEPTION(ArgParser{argParser}.parse(2, missingArgv), std::runtime_error,
+                     "Couldn't find [-a150, --arg150] mandatory argument in passed arguments");
+
+    char *exclusiveArgv[] = {binaryPath.data(), arg150.data(), arg190.data(), arg10.data()};
+    EXPECT_EXCEPTION(ArgParser{argParser}.parse(4, exclusiveArgv), std::runtime_error,
+                     "Mutually exclusive arguments can't be passed together: [-a10, --arg10], [-a190, --arg190]");
+
+    char *requiresArgv[] = {binaryPath.data(), arg150.data(), arg5.data()};
+    EXPECT_EXCEPTION(ArgParser{argParser}.parse(3, requiresArgv), std::runtime_error,
+                     "[-a5, --arg5] requires [-a199, --arg199] to be passed as well");
+
+    EXPECT_EXCEPTION(argParser.addAtLeastOne({"arg1", "arg200"}), std::runtime_error, "Unknown argument: arg200");
+}
+
+enum class Mode
+{
+    Fast,
+    Safe,
+    Audit
+};
+
+TEST_F(ArgParserTest, ChoiceArgumentTest)
+{
+    ArgParser argParser{};
+    argParser.addChoiceArgument("-m", "--mode", "run mode",
+                                std::vector<std::pair<std::string, Mode>>{{"fast",  Mode::Fast},
+                                                                          {"safe",  Mode::Safe},
+                                                                          {"audit", Mode::Audit}});
+    argParser.addChoiceArgumentWithDefault("-l", "--level", "log level",
+                                           std::vector<std::pair<std::string, int>>{{"debug", 10}, {"info", 20}},
+                                           "info");
+    std::string modeArg{"--mode=audit"};
+    char *argv[] = {binaryPath.data(), modeArg.data()};
+    argParser.parse(2, argv);
+
+    EXPECT_EQ(argParser.retrieve<Mode>("mode"), Mode::Audit);
+    EXPECT_EQ(argParser.retrieve<Mode>("m"), Mode::Audit);
+    EXPECT_EQ(argParser.retrieve("mode"), "audit");
+    EXPECT_EQ(argParser.retrieve<int>("level"), 20);
+    EXPECT_EQ(argParser.retrieveMayThrow<long>("l"), 20);
+    EXPECT_EQ(argParser.retrieve("level"), "info");
+}
+
+TEST_F(ArgParserTest, BadChoiceTest)
+{
+    ArgParser argParser{};
+    const std::vector<std::pair<std::string, Mode>> modes{{"fast", Mode::Fast}, {"safe", Mode::Safe}};
+    argParser.addChoiceArgument("-m", "--mode", "run mode", modes, true);
+
+    std::string modeArg{"-m=turbo"};
+    char *argv[] = {binaryPath.data(), modeArg.data()};
+    EXPECT_EXCEPTION(argParser.parse(2, argv), std::runtime_error,
+                     "Invalid value [turbo] for [-m, --mode], allowed values are: fast, safe");
+
+    std::istringstream input{"-m=Fast"};
+    EXPECT_EXCEPTION(argParser.parse(input, [](std::size_t, std::string_view) {}), std::runtime_error,
+                     "Invalid value [Fast] for [-m, --mode], allowed values are: fast, safe");
+
+    EXPECT_EXCEPTION(argParser.addChoiceArgumentWithDefault("-s", "--speed", "speed", modes, "slow"),
+                     std::runtime_error, "Default value [slow] of [-s, --speed] is not one of: fast, safe");
+    EXPECT_EXCEPTION(argParser.addChoiceArgument("-s", "--speed", "speed",
+                                                 std::vector<std::pair<std::string, int>>{{"a", 1}, {"a", 2}}),
+                     std::runtime_error, "Duplicate choice: a");
+    EXPECT_EXCEPTION(argParser.addChoiceArgument("-s", "--speed", "speed", std::vector<std::pair<std::string, int>>{}),
+                     std::runtime_error, "There must be at least one choice");
+    EXPECT_EXCEPTION(argParser.addChoiceArgument("-s", "--speed", "speed",
+                                                 std::vector<std::pair<std::string, std::uint64_t>>{
+                                                         {"max", std::numeric_limits<std::uint64_t>::max()}}),
+                     std::runtime_error, "Value of choice [max] of [-s, --speed] is too large, it must fit in "
+                                         "std::int64_t");
+
+    EXPECT_EQ(argParser.helpMsg(), "Following is a list of configured arguments:\n"
+                                   "-h, --help\n\tdescription: to get this message\n"
+                                   "-m, --mode\n\tdescription: run mode, mandatory: true, allowed: fast, safe\n");
+}
+
+TEST_F(ArgParserTest, ManyChoicesTest)
+{
+    std::vector<std::pair<std::string, int>> choices{};
+    for (int i = 0; i < 1000; ++i)
+    {
+        choices.emplace_back(concatenate("choice_", i), i * 3);
+    }
+
+    ArgParser argParser{};
+    argParser.addChoiceArgument("-c", "--choice", "one of many", choices);
+    for (const auto &choice : choices)
+    {
+        auto arg = concatenate("-c=", choice.first);
+        char *argv[] = {binaryPath.data(), arg.data()};
+        ArgParser copy{argParser};
+        copy.parse(2, argv);
+        ASSERT_EQ(copy.retrieve<int>("c"), choice.second);
+    }
+
+    std::string badArg{"-c=choice_1000"};
+    char *argv[] = {binaryPath.data(), badArg.data()};
+    EXPECT_THROW(argParser.parse(2, argv), std::runtime_error);
+}
+
+TEST_F(ArgParserTest, ManyArgumentsTest)
+{
+    ArgParser argParser{};
+    for (int i = 0; i < 3000; ++i)
+    {
+        argParser.addArgumentWithDefault(concatenate("-a", i), concatenate("--arg", i), "same help", i % 10);
+    }
+    EXPECT_EXCEPTION(argParser.addArgument("-a2999", "--otherArg", ""), std::runtime_error,
+                     "Duplicate arguments: -a2999, --otherArg");
+    EXPECT_EXCEPTION(argParser.addArgument("-o", "--arg1234", ""), std::runtime_error,
+                     "Duplicate arguments: -o, --arg1234");
+
+    std::string passedArg{"--arg1500=passed"};
+    char *argv[] = {binaryPath.data(), passedArg.data()};
+    argParser.parse(2, argv);
+    for (int i = 0; i < 3000; ++i)
+    {
+        if (i != 1500)
+        {
+            ASSERT_EQ(argParser.retrieve<int>(concatenate("a", i)), i % 10);
+            ASSERT_EQ(argParser.retrieve<int>(concatenate("arg", i)), i % 10);
+        }
+    }
+    EXPECT_EQ(argParser.retrieve("a1500"), "passed");
+    EXPECT_FALSE(argParser.contains("a3000"));
+    EXPECT_FALSE(argParser.contains("-a1"));
+}
+
+TEST_F(ArgParserTest, BulkArgumentsTest)
+{
+    ArgParser argParser{};
+    argParser.addArgument("-v", "--verbose", "verbose output");
+
+    std::vector<ArgParser::ArgSpec> args{{"-w", "--waitTime", "Wait time", "10"},
+                                         {"-l", "--logfile", "Log file", {}, true}};
+    for (int i = 0; i < 3000; ++i)
+    {
+        args.push_back({concatenate("-p", i), concatenate("--plugin", i), "plugin option", concatenate(i)});
+    }
+    argParser.addArguments(args);
+
+    char *noArgs[] = {binaryPath.data()};
+    EXPECT_EXCEPTION(argParser.parse(1, noArgs), std::runtime_error,
+                     "Couldn't find [-l, --logfile] mandatory argument in passed arguments");
+
+    std::string logFile{"-l=app.log"};
+    std::string plugin{"--plugin42=on"};
+    char *argv[] = {binaryPath.data(), logFile.data(), plugin.data()};
+    argParser.parse(3, argv);
+    EXPECT_EQ(argParser.retrieve("logfile"), "app.log");
+    EXPECT_EQ(argParser.retrieve<int>("w"), 10);
+    EXPECT_EQ(argParser.retrieve("p42"), "on");
+    EXPECT_EQ(argParser.retrieve<int>("plugin2999"), 2999);
+    EXPECT_FALSE(argParser.retrieve("verbose"));
+}
+
+TEST_F(ArgParserTest, BulkArgumentsConflictsTest)
+{
+    ArgParser argParser{};
+    argParser.addArgument("-v", "--verbose", "verbose output");
+    argParser.addArgumentWithDefault("-n", "--name", "name", "configured");
+
+    EXPECT_EXCEPTION(argParser.addArguments({{"-m", "--must", "new help", {}, true},
+                                             {"-a", "--alpha", ""},
+                                             {"-b", "-beta", ""},
+                                             {"-c", "--verbose", ""},
+                                             {"-a", "--apple", ""},
+                                             {"-d", "--delta", "", "1", true},
+                                             {"-apple", "--echo_apple", ""},
+                                             {"-f", "--fine", ""}}),
+                     std::runtime_error,
+                     "Couldn't add arguments:\n"
+                     "  Invalid long option: -beta\n"
+                     "  Mandatory argument [-d, --delta] can't have a default value\n"
+                     "  Duplicate argument [a] in: [-a, --alpha], [-a, --apple]\n"
+                     "  Duplicate argument [verbose] in: [-v, --verbose], [-c, --verbose]\n"
+                     "  Duplicate argument [apple] in: [-a, --apple], [-apple, --echo_apple]");
+
+    // none of them were added
+    EXPECT_EQ(argParser.slotOf("f"), ArgParser::npos);
+    EXPECT_EQ(argParser.slotOf("must"), ArgParser::npos);
+    argParser.addArguments({{"-f", "--fine", "new help", "new default"}});
+
+    char *argv[] = {binaryPath.data()};
+    argParser.parse(1, argv);
+    EXPECT_EQ(argParser.retrieve("name"), "configured");
+    EXPECT_EQ(argParser.retrieve("fine"), "new default");
+}
+
+TEST_F(ArgParserTest, SchemaJsonTest)
+{
+    ArgParser argParser{"an \"app\"\n"};
+    argParser.addArgument("-l", "--logfile", "Log file", true)
+             .addArgumentWithDefault("-w", "--waitTime", "Wait\ttime", 10)
+             .addChoiceArgumentWithDefault("-m", "--mode", "run mode", std::vector<std::pair<std::string, Mode>>{
+                     {"fast", Mode::Fast}, {"safe", Mode::Safe}}, "fast")
+             .addArgument("-u", "--user", "")
+             .addArgument("-p", "--password", "")
+             .addMutuallyExclusive({"w", "mode"})
+             .addAtLeastOne({"user", "w"})
+             .addRequires("p", "u");
+
+    const auto json = argParser.schemaJson();
+    EXPECT_EQ(json, "{\"description\": \"an \\\"app\\\"\\n\", \"arguments\": [\n"
+                    "  {\"short\": \"l\", \"long\": \"logfile\", \"help\": \"Log file\", \"mandatory\": true},\n"
+                    "  {\"short\": \"w\", \"long\": \"waitTime\", \"help\": \"Wait\\ttime\", \"default\": \"10\"},\n"
+                    "  {\"short\": \"m\", \"long\": \"mode\", \"help\": \"run mode\", \"default\": \"fast\", "
+                    "\"choices\": {\"fast\": 0, \"safe\": 1}},\n"
+                    "  {\"short\": \"u\", \"long\": \"user\", \"help\": \"\"},\n"
+                    "  {\"short\": \"p\", \"long\": \"password\", \"help\": \"\"}], \"constraints\": [\n"
+                    "  {\"kind\": \"mutuallyExclusive\", \"arguments\": [\"waitTime\", \"mode\"]},\n"
+                    "  {\"kind\": \"atLeastOne\", \"arguments\": [\"waitTime\", \"user\"]},\n"
+                    "  {\"kind\": \"requires\", \"argument\": \"password\", \"required\": [\"user\"]}]}\n");
+
+    const auto imported = ArgParser::fromSchemaJson(json);
+    EXPECT_EQ(imported.getDescription(), "an \"app\"\n");
+    EXPECT_EQ(imported.schemaJson(), json);
+    EXPECT_EQ(imported.helpMsg(), argParser.helpMsg());
+}
+
+TEST_F(ArgParserTest, ArgValidatorTest)
+{
+    ArgParser argParser{"validated app"};
+    argParser.addArgument("-l", "--logfile", "Log file", true)
+             .addChoiceArgument("-m", "--mode", "run mode", std::vector<std::pair<std::string, Mode>>{
+                     {"fast", Mode::Fast}, {"safe", Mode::Safe}})
+             .addArgument("-u", "--user", "")
+             .addArgument("-p", "--password", "")
+             .addRequires("p", "u");
+
+    ArgValidator validator{argParser.schemaJson()};
+    EXPECT_EQ(validator.getDescription(), "validated app");
+    EXPECT_EQ(validator.validate({"app", "-l=app.log", "--mode=safe"}), std::nullopt);
+    EXPECT_EQ(validator.validate({"app", "--help"}), std::nullopt);
+    EXPECT_EQ(validator.validate({"app", "-l=app.log", "--mode=slow"}),
+              "Invalid value [slow] for [-m, --mode], allowed values are: fast, safe");
+    EXPECT_EQ(validator.validate({"app", "-m=fast"}),
+              "Couldn't find [-l, --logfile] mandatory argument in passed arguments");
+    EXPECT_EQ(validator.validate({"app", "-l=app.log", "-p=secret"}),
+              "[-p, --password] requires [-u, --user] to be passed as well");
+    EXPECT_EQ(validator.validate({"app", "-l=app.log", "--other=1"}), "Unknown argument: other");
+
+    // the same messages as parse()
+    std::string logFile{"-l=app.log"};
+    std::string password{"-p=secret"};
+    char *argv[] = {binaryPath.data(), logFile.data(), password.data()};
+    EXPECT_EQ(validator.validate(3, argv), "[-p, --password] requires [-u, --user] to be passed as well");
+    EXPECT_EXCEPTION(argParser.parse(3, argv), std::runtime_error,
+                     "[-p, --password] requires [-u, --user] to be passed as well");
+
+    ArgParser interpolated{};
+    interpolated.addArgument("-a", "--aa", "first")
+        .addArgumentWithDefault("-b", "--bb", "second", "${aa}/b")
+        .enableInterpolation();
+    const auto json = interpolated.schemaJson();
+    EXPECT_EQ(json.substr(0, json.find('[') + 1),
+              "{\"description\": \"\", \"interpolation\": true, \"arguments\": [");
+    EXPECT_EQ(ArgParser::fromSchemaJson(json).schemaJson(), json);
+
+    ArgValidator interpolatedValidator{json};
+    EXPECT_EQ(interpolatedValidator.validate({"app", "--aa=${env:HOME}"}), std::nullopt);
+    EXPECT_EQ(interpolatedValidator.validate({"app", "--aa=${bb}", "--bb=${aa}"}),
+              "Cyclic interpolation: [-a, --aa] -> [-b, --bb] -> [-a, --aa]");
+    EXPECT_EQ(interpolatedValidator.validate({"app", "--aa=${bb}"}), // the default value of bb is checked as well
+              "Cyclic interpolation: [-a, --aa] -> [-b, --bb] -> [-a, --aa]");
+    EXPECT_EQ(interpolatedValidator.validate({"app", "--aa=${cc}"}),
+              "Invalid value [${cc}] for [-a, --aa], unknown argument: cc");
+    EXPECT_EQ(ArgValidator{argParser.schemaJson()}.validate({"app", "-l=${user}"}), std::nullopt); // not enabled
+}
+
+TEST_F(ArgParserTest, InvalidSchemaJsonTest)
+{
+    EXPECT_EXCEPTION(ArgParser::fromSchemaJson(""), std::runtime_error,
+                     "Invalid schema JSON at offset 0, expected a value");
+    EXPECT_EXCEPTION(ArgParser::fromSchemaJson("{\"arguments\": [}"), std::runtime_error,
+                     "Invalid schema JSON at offset 15, expected a value");
+    EXPECT_EXCEPTION(ArgParser::fromSchemaJson("{\"arguments\": []} []"), std::runtime_error,
+                     "Invalid schema JSON at offset 18, expected end of input");
+    EXPECT_EXCEPTION(ArgParser::fromSchemaJson(std::string(100, '[')), std::runtime_error,
+                     "Invalid schema JSON at offset 65, expected less nesting");
+    EXPECT_EXCEPTION(ArgParser::fromSchemaJson("{\"arguments\": {}}"), std::runtime_error,
+                     "Invalid schema: \"arguments\" must be an array");
+    EXPECT_EXCEPTION(ArgParser::fromSchemaJson("{\"interpolation\": 1, \"arguments\": []}"), std::runtime_error,
+                     "Invalid schema: \"interpolation\" must be a boolean");
+    EXPECT_EXCEPTION(ArgParser::fromSchemaJson("{\"arguments\": [{\"short\": \"l\"}]}"), std::runtime_error,
+                     "Invalid schema: each argument must have \"short\" and \"long\"");
+    EXPECT_EXCEPTION(ArgParser::fromSchemaJson("{\"arguments\": [{\"short\": \"l\", \"long\": \"log\", "
+                                               "\"mandatory\": \"yes\"}]}"), std::runtime_error,
+                     "Invalid schema: \"mandatory\" of an argument must be a boolean");
+    EXPECT_EXCEPTION(ArgParser::fromSchemaJson("{\"arguments\": [{\"short\": \"l\", \"long\": \"log\", "
+                                               "\"choices\": {\"a\": 1.5}}]}"), std::runtime_error,
+                     "Invalid schema: choice [a] of [-l, --log] must map to an integer");
+    EXPECT_EXCEPTION(ArgParser::fromSchemaJson("{\"arguments\": [{\"short\": \"l\", \"long\": \"l\"}]}"),
+                     std::runtime_error, "Short option [-l] must be shorter than Long option [--l]");
+    EXPECT_EXCEPTION(ArgParser::fromSchemaJson("{\"arguments\": [], \"constraints\": [{\"kind\": \"any\"}]}"),
+                     std::runtime_error, "Invalid schema: unknown constraint [any]");
+
+    // escapes are decoded as UTF-8
+    const auto argParser = ArgParser::fromSchemaJson("{\"description\": \"\\u00e9\\ud83d\\ude00\\/\", "
+                                                     "\"arguments\": []}");
+    EXPECT_EQ(argParser.getDescription(), "\xc3\xa9\xf0\x9f\x98\x80/");
+}
+
+TEST_F(ArgParserTest, TypedHandlesTest)
+{
+    ArgParser argParser{};
+    const auto waitTime = argParser.addTypedArgumentWithDefault("-w", "--waitTime", "Wait time", 10);
+    const auto logFile = argParser.addTypedArgument("-l", "--logfile", "Log file", true);
+    const auto ratio = argParser.addTypedArgument<double>("-r", "--ratio", "ratio");
+    const auto name = argParser.addTypedArgumentWithDefault<std::string>("-n", "--name", "name", "app");
+    argParser.addChoiceArgument("-m", "--mode", "run mode", std::vector<std::pair<std::string, Mode>>{
+            {"fast", Mode::Fast}, {"safe", Mode::Safe}});
+    const auto mode = argParser.optOf<Mode>("mode");
+    EXPECT_EQ(argParser.optOf<int>("w").slot(), waitTime.slot());
+    EXPECT_EXCEPTION(argParser.optOf("other"), std::runtime_error, "Unknown argument: other");
+
+    std::string logFileArg{"--logfile=app.log"};
+    std::string ratioArg{"-r=half"};
+    std::string modeArg{"-m=safe"};
+    char *argv[] = {binaryPath.data(), logFileArg.data(), ratioArg.data(), modeArg.data()};
+    argParser.parse(4, argv);
+
+    const std::optional<int> waitTimeValue = argParser.retrieve(waitTime);
+    EXPECT_EQ(waitTimeValue, 10);
+    EXPECT_EQ(argParser.retrieveMayThrow(logFile), "app.log");
+    EXPECT_EQ(argParser.retrieve(name), "app");
+    EXPECT_EQ(argParser.retrieve(mode), Mode::Safe);
+    EXPECT_EQ(argParser.retrieve(ratio), std::nullopt);
+    EXPECT_EXCEPTION(argParser.retrieveMayThrow(ratio), std::runtime_error, "Type conversion failed for ratio");
+
+    // a handle reads from the slot, so it works for a copy as well
+    const auto copy = argParser;
+    EXPECT_EQ(copy.retrieve(logFile), "app.log");
+
+    // but not for a parser which doesn't have that slot
+    ArgParser smaller{};
+    smaller.addArgument("-l", "--logfile", "Log file");
+    char *smallerArgv[] = {binaryPath.data(), logFileArg.data()};
+    smaller.parse(2, smallerArgv);
+    EXPECT_EQ(smaller.retrieve(name), std::nullopt);
+    EXPECT_EXCEPTION(smaller.retrieveMayThrow(name), std::runtime_error,
+                     concatenate("Unknown argument handle of slot ", name.slot()));
+}
+
+TEST_F(ArgParserTest, OverridesTest)
+{
+    ArgParser argParser{};
+    argParser.addArgument(logFileShortOption, logFileLongOption, logFileHelpMessage, true)
+             .addArgumentWithDefault("-w", "--waitTime", "Wait time", 5)
+             .addArgumentWithDefault("-c", "--counter", "Counter", 10)
+             .addArgument("-n", "--number", "Number")
+             .addChoiceArgumentWithDefault("-m", "--mode", "run mode", std::vector<std::pair<std::string, Mode>>{
+                     {"fast", Mode::Fast}, {"safe", Mode::Safe}, {"audit", Mode::Audit}}, "fast");
+
+    argParser.setOverride("waitTime", 7).setOverride("c", 20).setOverride("c", 30).setOverride("mode", "audit");
+    EXPECT_EXCEPTION(argParser.setOverride("mode", "slow"), std::runtime_error,
+                     "Invalid value [slow] for [-m, --mode], allowed values are: fast, safe, audit");
+    EXPECT_EXCEPTION(argParser.setOverride("other", 1), std::runtime_error, "Unknown argument: other");
+
+    // overrides don't count as passed
+    char *noArgs[] = {binaryPath.data()};
+    EXPECT_EXCEPTION(argParser.parse(1, noArgs), std::runtime_error,
+                     concatenate("Couldn't find [", logFileShortOption, ", ", logFileLongOption,
+                                 "] mandatory argument in passed arguments"));
+
+    // passed values come first, then overrides, then default values
+    std::string waitArg{"-w=12"};
+    char *argv[] = {binaryPath.data(), logFilePathLongOption.data(), waitArg.data()};
+    argParser.parse(3, argv);
+    EXPECT_EQ(argParser.retrieve<int>("w"), 12);
+    EXPECT_EQ(argParser.retrieve<int>("c"), 30);
+    EXPECT_EQ(argParser.retrieve<Mode>("mode"), Mode::Audit);
+    EXPECT_EQ(argParser.retrieve("number"), std::nullopt);
+
+    // resolved when retrieved, so these can be changed after parse
+    argParser.setOverride("number", 3).clearOverrides().setOverride("n", 4);
+    EXPECT_EQ(argParser.retrieve<int>("c"), 10);
+    EXPECT_EQ(argParser.retrieve<Mode>("mode"), Mode::Fast);
+    EXPECT_EQ(argParser.retrieve<int>("number"), 4);
+    EXPECT_TRUE(argParser.contains("number"));
+
+    std::vector<std::pair<std::size_t, std::string>> visited{};
+    argParser.parse(3, argv, [&visited](std::size_t slot, std::string_view value)
+    {
+        visited.emplace_back(slot, std::string{value});
+    });
+    const std::vector<std::pair<std::size_t, std::string>> expected{
+            {argParser.slotOf("l"), logFilePath},
+            {argParser.slotOf("w"), "12"},
+            {argParser.slotOf("c"), "10"},
+            {argParser.slotOf("n"), "4"},
+            {argParser.slotOf("m"), "fast"}};
+    EXPECT_EQ(visited, expected);
+}
+
+TEST_F(ArgParserTest, ListValuesTest)
+{
+    ArgParser argParser{};
+    argParser.addArgument("-i", "--ids", "ids");
+    argParser.addArgument("-n", "--names", "names");
+    argParser.addArgumentWithDefault("-r", "--ratios", "ratios", "0.5,1.25");
+    argParser.addArgument("-e", "--empty", "nothing");
+    argParser.addArgumentWithDefault("-t", "--trailing", "ends with a delimiter", "1,2,");
+    const auto ids = argParser.addTypedArgument<std::vector<long>>("-l", "--large", "many ids");
+
+    std::string largeArg{"--large="};
+    for (int i = 0; i < 50000; ++i)
+    {
+        largeArg += concatenate(i == 0 ? "" : ",", i * 3);
+    }
+    std::string idsArg{"-i=1,-2,30"};
+    std::string namesArg{"--names=a,,b c"};
+    std::string emptyArg{"-e="};
+    char *argv[] = {binaryPath.data(), idsArg.data(), namesArg.data(), emptyArg.data(), largeArg.data()};
+    argParser.parse(5, argv);
+
+    EXPECT_EQ(argParser.retrieve<std::vector<int>>("ids"), (std::vector<int>{1, -2, 30}));
+    EXPECT_EQ(argParser.retrieve<std::vector<unsigned>>("ids"), std::nullopt);
+    EXPECT_EQ(argParser.retrieve<std::vector<std::string>>("n"), (std::vector<std::string>{"a", "", "b c"}));
+    EXPECT_EQ(argParser.retrieve<std::vector<int>>("n"), std::nullopt);
+    EXPECT_EQ(argParser.retrieve<std::vector<double>>("ratios"), (std::vector<double>{0.5, 1.25}));
+    EXPECT_EQ(argParser.retrieve<std::vector<int>>("empty"), std::vector<int>{});
+    EXPECT_EQ(argParser.retrieve("ids"), "1,-2,30");
+    EXPECT_EQ(argParser.retrieve<std::vector<int>>("trailing"), (std::vector<int>{1, 2}));
+    EXPECT_EQ(argParser.retrieve<std::vector<std::string>>("trailing"), (std::vector<std::string>{"1", "2"}));
+
+    const auto large = argParser.retrieveMayThrow(ids);
+    ASSERT_EQ(large.size(), 50000);
+    EXPECT_EQ(large.capacity(), large.size()); // reserved from the count of delimiters
+    EXPECT_EQ(large.front(), 0);
+    EXPECT_EQ(large.back(), 49999 * 3);
+
+    argParser.setListDelimiter(' ');
+    EXPECT_EQ(argParser.retrieve<std::vector<std::string>>("names"), (std::vector<std::string>{"a,,b", "c"}));
+    EXPECT_EQ(argParser.retrieve<std::vector<int>>("ids"), std::nullopt);
+    argParser.setListDelimiter('-');
+    EXPECT_EQ(argParser.retrieve<std::vector<std::string>>("ids"), (std::vector<std::string>{"1,", "2,30"}));
+    EXPECT_EQ(argParser.retrieve<std::vector<int>>("large"), std::nullopt);
+}
+
+TEST_F(ArgParserTest, FloatParserTest)
+{
+    const auto expectSame = [](const std::string &text)
+    {
+        double value{};
+        const auto [ptr, ec] = FloatParser::parse(text.data(), text.data() + text.size(), value);
+        const auto expected = std::strtod(text.c_str(), nullptr);
+        ASSERT_EQ(ec, std::errc{}) << text;
+        EXPECT_EQ(ptr, text.data() + text.size()) << text;
+        EXPECT_EQ(std::memcmp(&value, &expected, sizeof(value)), 0) << text;
+
+        float floatValue{};
+        const auto floatExpected = std::strtof(text.c_str(), nullptr);
+        if (FloatParser::parse(text.data(), text.data() + text.size(), floatValue).ec == std::errc{})
+        {
+            EXPECT_EQ(std::memcmp(&floatValue, &floatExpected, sizeof(floatValue)), 0) << text;
+        }
+    };
+
+    for (const auto *text : {"0", "-0", "1", "0.1", ".5", "5.", "00012", "1e22", "1e23", "9007199254740993",
+                             "2.2250738585072011e-308", "2.2250738585072014e-308", "4.9406564584124654e-324",
+                             "2.4703282292062328e-324", "1.7976931348623157e308", "1.7976931348623158e308",
+                             "123456789012345678901234567890", "3.4028235e38", "1.17549435e-38", "1e-45"})
+    {
+        expectSame(text);
+    }
+
+    std::mt19937_64 random{42};
+    char buffer[1200];
+    for (int i = 0; i < 100000; ++i)
+    {
+        const auto bits = random();
+        double value{};
+        std::memcpy(&value, &bits, sizeof(value));
+        if (std::isfinite(value))
+        {
+            std::snprintf(buffer, sizeof(buffer), i % 2 ? "%.17g" : "%.15g", value);
+            expectSame(buffer);
+        }
+    }
+
+    // middle of two doubles is exact in a long double with a 64 bit mantissa, and has hundreds of digits
+    if (std::numeric_limits<long double>::digits >= 64)
+    {
+        for (int i = 0; i < 2000; ++i)
+        {
+            auto bits = random() & 0x7FFFFFFFFFFFFFFFull;
+            bits &= i % 4 ? ~0ull : 0x000FFFFFFFFFFFFFull; // subnormals
+            double value{};
+            std::memcpy(&value, &bits, sizeof(value));
+            const auto next = std::nextafter(value, std::numeric_limits<double>::infinity());
+            if (!std::isfinite(next))
+            {
+                continue;
+            }
+            std::snprintf(buffer, sizeof(buffer), "%.800Le", (static_cast<long double>(value) + next) / 2);
+            const std::string text{buffer};
+            const auto exponent = text.find('e');
+            const auto digits = text.substr(0, text.find_last_not_of('0', exponent - 1) + 1);
+            expectSame(digits + text.substr(exponent));
+            expectSame(digits + std::string(1000, '0') + "1" + text.substr(exponent));
+        }
+    }
+}
+
+TEST_F(ArgParserTest, FloatParserSyntaxTest)
+{
+    struct Case
+    {
+        std::string text;
+        std::size_t consumed;
+        std::errc ec;
+    };
+    const std::vector<Case> cases{{"", 0, std::errc::invalid_argument},
+                                  {"-", 0, std::errc::invalid_argument},
+                                  {".", 0, std::errc::invalid_argument},
+                                  {"+1", 0, std::errc::invalid_argument},
+                                  {" 1", 0, std::errc::invalid_argument},
+                                  {"e5", 0, std::errc::invalid_argument},
+                                  {"1e", 1, std::errc{}},
+                                  {"1e+", 1, std::errc{}},
+                                  {"1e5x", 3, std::errc{}},
+                                  {"1_000", 1, std::errc{}},
+                                  {"0x1p3", 1, std::errc{}},
+                                  {"inf", 3, std::errc{}},
+                                  {"-Infinity", 9, std::errc{}},
+                                  {"infinit", 3, std::errc{}},
+                                  {"nan(", 3, std::errc{}},
+                                  {"NaN(a_1)x", 8, std::errc{}},
+                                  {"1e400", 5, std::errc::result_out_of_range},
+                                  {"1e-400", 6, std::errc::result_out_of_range},
+                                  {"0e999999999999999999999", 23, std::errc{}}};
+    for (const auto &[text, consumed, ec] : cases)
+    {
+        double value{-1};
+        const auto result = FloatParser::parse(text.data(), text.data() + text.size(), value);
+        EXPECT_EQ(result.ptr, text.data() + consumed) << text;
+        EXPECT_EQ(result.ec, ec) << text;
+        if (ec == std::errc::invalid_argument || ec == std::errc::result_out_of_range)
+        {
+            EXPECT_EQ(value, -1) << text;
+        }
+    }
+
+    double value{};
+    std::string text{"-Inf"};
+    FloatParser::parse(text.data(), text.data() + text.size(), value);
+    EXPECT_EQ(value, -std::numeric_limits<double>::infinity());
+    text = "-nan";
+    FloatParser::parse(text.data(), text.data() + text.size(), value);
+    EXPECT_TRUE(std::isnan(value));
+    text = "-0.0e10";
+    FloatParser::parse(text.data(), text.data() + text.size(), value);
+    EXPECT_TRUE(value == 0 && std::signbit(value));
+    float floatValue{};
+    text = "1e39";
+    EXPECT_EQ(FloatParser::parse(text.data(), text.data() + text.size(), floatValue).ec,
+              std::errc::result_out_of_range);
+    text = "1e-40"; // subnormal
+    EXPECT_EQ(FloatParser::parse(text.data(), text.data() + text.size(), floatValue).ec, std::errc{});
+    EXPECT_EQ(floatValue, std::strtof("1e-40", nullptr));
+}
+
+TEST_F(ArgParserTest, QuantitiesTest)
+{
+    using namespace std::chrono_literals;
+    using Deciseconds = std::chrono::duration<int, std::ratio<1, 10>>;
+    ArgParser argParser{};
+    argParser.addArgumentWithDefault("-b", "--buffer", "buffer size", ArgParser::ByteSize{64u << 20u});
+    argParser.addArgumentWithDefault("-t", "--timeout", "timeout", 250ms);
+    argParser.addArgumentWithDefault("-c", "--connections", "connections", ArgParser::Count{3000000});
+    argParser.addArgumentWithDefault("-r", "--rate", "rate", ArgParser::Rate{0.1});
+    argParser.addArgumentWithDefault("-d", "--deciseconds", "deciseconds", Deciseconds{5});
+    argParser.addArgumentWithDefault("-s", "--small", "small buffer", ArgParser::ByteSize{1000});
+    const auto interval = argParser.addTypedArgumentWithDefault("-i", "--interval", "interval", 2min);
+    argParser.addArgument("-v", "--value", "any value");
+    argParser.addArgument("-n", "--numbers", "numbers");
+
+    const auto retrieveWith = [&argParser](const std::string &value)
+    {
+        std::string app{"app"}, arg{"--value=" + value};
+        char *argv[] = {app.data(), arg.data()};
+        argParser.parse(2, argv);
+    };
+
+    retrieveWith("");
+    EXPECT_EQ(argParser.retrieve("buffer"), "64MiB");
+    EXPECT_EQ(argParser.retrieve<ArgParser::ByteSize>("buffer"), ArgParser::ByteSize{64u << 20u});
+    EXPECT_EQ(argParser.retrieve("timeout"), "250ms");
+    EXPECT_EQ(argParser.retrieve<std::chrono::milliseconds>("timeout"), 250ms);
+    EXPECT_EQ(argParser.retrieve<std::chrono::seconds>("timeout"), std::nullopt); // not a whole number
+    EXPECT_EQ(argParser.retrieve("connections"), "3M");
+    EXPECT_EQ(argParser.retrieve<ArgParser::Count>("connections"), ArgParser::Count{3000000});
+    EXPECT_EQ(argParser.retrieve<ArgParser::Rate>("rate"), ArgParser::Rate{0.1});
+    EXPECT_EQ(argParser.retrieve("deciseconds"), "5");
+    EXPECT_EQ(argParser.retrieve<Deciseconds>("deciseconds"), Deciseconds{5});
+    EXPECT_EQ(argParser.retrieve("small"), "1kB");
+    EXPECT_EQ(argParser.retrieve("interval"), "2min");
+    EXPECT_EQ(argParser.retrieve(interval), 2min);
+    EXPECT_EQ(argParser.retrieve<ArgParser::ByteSize>("value"), std::nullopt);
+
+    const std::vector<std::pair<std::string, std::optional<std::uint64_t>>> byteSizes{
+            {"4096", 4096}, {"1.5GiB", 3ull << 29u}, {"512kB", 512000}, {"0B", 0}, {"15EiB", 15ull << 60u},
+            {"0.3KiB", std::nullopt}, {"16EiB", std::nullopt}, {"1XB", std::nullopt}, {"-1B", std::nullopt},
+            {"MiB", std::nullopt}, {"1.MiB", std::nullopt}, {"1 MiB", std::nullopt}};
+    for (const auto &[value, bytes] : byteSizes)
+    {
+        retrieveWith(value);
+        const auto retrieved = argParser.retrieve<ArgParser::ByteSize>("value");
+        EXPECT_EQ(retrieved ? std::optional<std::uint64_t>{retrieved->bytes} : std::nullopt, bytes) << value;
+    }
+
+    retrieveWith("2.5M");
+    EXPECT_EQ(argParser.retrieve<ArgParser::Count>("value"), ArgParser::Count{2500000});
+    retrieveWith("1.0001k");
+    EXPECT_EQ(argParser.retrieve<ArgParser::Count>("value"), std::nullopt);
+
+    retrieveWith("1.5s");
+    EXPECT_EQ(argParser.retrieve<std::chrono::milliseconds>("value"), 1500ms);
+    EXPECT_EQ(argParser.retrieve<std::chrono::nanoseconds>("value"), 1500000000ns);
+    EXPECT_EQ(argParser.retrieve<std::chrono::seconds>("value"), std::nullopt);
+    EXPECT_EQ(argParser.retrieve<std::chrono::duration<double>>("value"), std::chrono::duration<double>{1.5});
+    retrieveWith("-5min");
+    EXPECT_EQ(argParser.retrieve<std::chrono::seconds>("value"), -300s);
+    retrieveWith("3");
+    EXPECT_EQ(argParser.retrieve<std::chrono::milliseconds>("value"), 3ms);
+    EXPECT_EQ(argParser.retrieve<std::chrono::hours>("value"), 3h);
+    retrieveWith("30d");
+    EXPECT_EQ(argParser.retrieve<std::chrono::seconds>("value"), 2592000s);
+    EXPECT_EQ((argParser.retrieve<std::chrono::duration<int, std::milli>>("value")), std::nullopt); // overflow
+    retrieveWith("1500us");
+    EXPECT_EQ(argParser.retrieve<std::chrono::microseconds>("value"), 1500us);
+    EXPECT_EQ(argParser.retrieve<std::chrono::milliseconds>("value"), std::nullopt);
+    retrieveWith("5 s");
+    EXPECT_EQ(argParser.retrieve<std::chrono::seconds>("value"), std::nullopt);
+
+    const std::vector<std::pair<std::string, std::optional<double>>> rates{
+            {"10k/s", 10000}, {"5/ms", 5000}, {"120/min", 2}, {"3", 3}, {"2.5", 2.5}, {"1E/s", 1e18},
+            {"10/x", std::nullopt}, {"10/", std::nullopt}, {"-1/s", std::nullopt}, {"/s", std::nullopt},
+            {"inf/s", std::nullopt}};
+    for (const auto &[value, perSecond] : rates)
+    {
+        retrieveWith(value);
+        const auto retrieved = argParser.retrieve<ArgParser::Rate>("value");
+        EXPECT_EQ(retrieved ? std::optional<double>{retrieved->perSecond} : std::nullopt, perSecond) << value;
+    }
+}
+
+TEST_F(ArgParserTest, IntegerPrefixesTest)
+{
+    ArgParser argParser{};
+    argParser.addArgument("-v", "--value", "any value");
+    const auto retrieveWith = [&argParser](const std::string &value)
+    {
+        std::string app{"app"}, arg{"--value=" + value};
+        char *argv[] = {app.data(), arg.data()};
+        argParser.parse(2, argv);
+    };
+
+    retrieveWith("0x1F");
+    EXPECT_EQ(argParser.retrieve<int>("value"), 31);
+    EXPECT_EQ(argParser.retrieve<double>("value"), std::nullopt);
+    retrieveWith("-0X10");
+    EXPECT_EQ(argParser.retrieve<int>("value"), -16);
+    EXPECT_EQ(argParser.retrieve<unsigned>("value"), std::nullopt);
+    retrieveWith("0b101");
+    EXPECT_EQ(argParser.retrieve<std::uint8_t>("value"), 5);
+    retrieveWith("-0x80");
+    EXPECT_EQ(argParser.retrieve<std::int8_t>("value"), -128);
+    retrieveWith("0x80");
+    EXPECT_EQ(argParser.retrieve<std::int8_t>("value"), std::nullopt);
+    EXPECT_EQ(argParser.retrieve<std::uint8_t>("value"), 128);
+    retrieveWith("-0x8000000000000000");
+    EXPECT_EQ(argParser.retrieve<std::int64_t>("value"), std::numeric_limits<std::int64_t>::min());
+    retrieveWith("0xFFFFFFFFFFFFFFFF");
+    EXPECT_EQ(argParser.retrieve<std::uint64_t>("value"), std::numeric_limits<std::uint64_t>::max());
+    EXPECT_EQ(argParser.retrieve<std::int64_t>("value"), std::nullopt);
+    for (const auto *invalid : {"0x", "0b", "0x-5", "0b12", "0xg", "0x 1", "-"})
+    {
+        retrieveWith(invalid);
+        EXPECT_EQ(argParser.retrieve<int>("value"), std::nullopt) << invalid;
+    }
+    retrieveWith("0x10,0b11,-5,0");
+    EXPECT_EQ(argParser.retrieve<std::vector<int>>("value"), (std::vector<int>{16, 3, -5, 0}));
+}
+
+TEST_F(ArgParserTest, FingerprintTest)
+{
+    const auto configure = [](ArgParser &argParser, bool reversed)
+    {
+        std::vector<ArgParser::ArgSpec> args{{"-a", "--alpha", "alpha"},
+                                             {"-b", "--beta", "beta", "x"},
+                                             {"-v", "--verbose", "verbose logs", "false"},
+                                             {"-t", "--threads", "threads"}};
+        if (reversed)
+        {
+            std::reverse(args.begin(), args.end());
+        }
+        argParser.addArguments(args).excludeFromFingerprint({"verbose", "t"});
+    };
+
+    ArgParser argParser{};
+    configure(argParser, false);
+    EXPECT_EXCEPTION(argParser.fingerprint(), std::runtime_error,
+                     "parse() must be called with command line arguments before retrieving values");
+
+    const auto fingerprint = parse(argParser, {"--alpha=1", "--beta=2", "--verbose=true"}).fingerprint();
+    EXPECT_EQ(argParser.canonicalConfig(), "alpha=1\nbeta=2\n");
+    EXPECT_EQ(parse(argParser, {"-b=2", "-t=8", "-a=1"}).fingerprint(), fingerprint); // excluded ones don't count
+    EXPECT_NE(parse(argParser, {"-a=1", "-b=3"}).fingerprint(), fingerprint);
+    EXPECT_NE(parse(argParser, {"-a=2", "-b=1"}).fingerprint(), fingerprint);
+    EXPECT_NE(parse(argParser, {"-a=1"}).fingerprint().low, fingerprint.low);
+    EXPECT_EQ(argParser.canonicalConfig(), "alpha=1\nbeta=x\n"); // default value is a part of it
+    EXPECT_EQ(parse(argParser, {"-a=1", "-b=x"}).fingerprint(), parse(argParser, {"-a=1"}).fingerprint());
+    EXPECT_NE(parse(argParser, {"-a="}).fingerprint(), parse(argParser, {}).fingerprint());
+
+    ArgParser reversed{};
+    configure(reversed, true);
+    EXPECT_EQ(parse(reversed, {"--verbose=true", "--beta=2", "--alpha=1"}).fingerprint(), fingerprint);
+    EXPECT_EQ(reversed.canonicalConfig(), "alpha=1\nbeta=2\n");
+    EXPECT_EQ(fingerprint.toHex().size(), 32);
+    EXPECT_EQ((ArgParser::Fingerprint{0x1F, 0xAB}.toHex()), "00000000000000ab000000000000001f");
+
+    reversed.setOverride("alpha", "3");
+    EXPECT_EQ(parse(reversed, {"-b=2"}).fingerprint(), parse(argParser, {"-a=3", "-b=2"}).fingerprint());
+    parse(reversed, {"--beta=a\nb\\c"});
+    EXPECT_EQ(reversed.canonicalConfig(), "alpha=3\nbeta=a\\nb\\\\c\n");
+
+    auto fromSchema = ArgParser::fromSchemaJson(argParser.schemaJson());
+    EXPECT_EQ(parse(fromSchema, {"-a=1", "-b=2", "-v=true", "-t=2"}).fingerprint(), fingerprint);
+    EXPECT_EXCEPTION(argParser.excludeFromFingerprint({"alpha", "gamma"}), std::runtime_error,
+                     "Unknown argument: gamma");
+    EXPECT_EQ(parse(argParser, {"-a=1", "-b=2"}).fingerprint(), fingerprint); // nothing was excluded
+}
+
+TEST_F(ArgParserTest, BoundArgumentsTest)
+{
+    struct Config
+    {
+        std::string logFile{};
+        int waitTime{0};
+        std::chrono::milliseconds timeout{5};
+        std::vector<int> ids{};
+        bool verbose{true};
+    };
+
+    Config config{};
+    ArgParser argParser{};
+    argParser.addBoundArgument("-l", "--logfile", "log file", config, &Config::logFile, true)
+        .addBoundArgumentWithDefault("-w", "--waitTime", "wait time", config, &Config::waitTime, 10)
+        .addBoundArgument("-t", "--timeout", "timeout", config, &Config::timeout)
+        .addBoundArgument("-i", "--ids", "ids", config, &Config::ids)
+        .addBoundArgument("-v", "--verbose", "verbose logs", config, &Config::verbose);
+
+    parse(argParser, {"--logfile=app.log", "-t=2s", "-i=3,1,2"});
+    EXPECT_EQ(config.logFile, "app.log");
+    EXPECT_EQ(config.waitTime, 10); // default value is written
+    EXPECT_EQ(config.timeout, std::chrono::seconds{2});
+    EXPECT_EQ(config.ids, (std::vector<int>{3, 1, 2}));
+    EXPECT_TRUE(config.verbose); // unset arguments keep the initial value
+    EXPECT_EQ(argParser.retrieve<int>("waitTime"), 10);
+
+    argParser.setOverride("verbose", "false");
+    parse(argParser, {"-l=other.log", "-w=20"});
+    EXPECT_EQ(config.logFile, "other.log");
+    EXPECT_EQ(config.waitTime, 20);
+    EXPECT_FALSE(config.verbose);
+
+    EXPECT_EXCEPTION(parse(argParser, {"-w=30"}), std::runtime_error,
+                     "Couldn't find [-l, --logfile] mandatory argument in passed arguments");
+    EXPECT_EQ(config.waitTime, 20); // nothing is written when parsing fails
+    EXPECT_EXCEPTION(parse(argParser, {"-l=a.log", "-w=abc"}), std::runtime_error,
+                     "Invalid value [abc] for [-w, --waitTime], it can't be converted to its bound member");
+    EXPECT_EQ(config.logFile, "other.log"); // nor when a member can't be converted, even the ones before it
+
+    parse(argParser, {"--help"});
+    EXPECT_EQ(config.logFile, "other.log"); // help writes none
+}
+
+ARG_PARSER_FLAG(int, b, batch_size, 32, "items per batch");
+ARG_PARSER_FLAG(std::string, q, queue_name, "jobs", "queue name");
+ARG_PARSER_FLAG(std::chrono::milliseconds, f, flush_time, std::chrono::milliseconds{100}, "flush time");
+
+// Flags are process wide and can only be parsed once, so this test can't be repeated in one run, e.g. with
+// --gtest_repeat, and is skipped after its first run
+TEST_F(ArgParserTest, FlagsTest)
+{
+    static bool ran{false};
+    if (std::exchange(ran, true))
+    {
+        GTEST_SKIP() << "flags were already parsed by an earlier run of this test";
+    }
+
+    EXPECT_EQ(*FLAGS_batch_size, 32); // default values till flags are parsed
+    EXPECT_EQ(FLAGS_queue_name->size(), 4);
+
+    std::string batchArg{"--batch_size=64"};
+    std::string flushArg{"-f=2s"};
+    char *argv[] = {binaryPath.data(), batchArg.data(), flushArg.data()};
+    ArgParser::parseFlags(3, argv);
+
+    std::atomic<int> sum{0};
+    std::vector<std::thread> readers{};
+    for (int i = 0; i < 4; ++i)
+    {
+        readers.emplace_back([&sum]() { sum += *FLAGS_batch_size; });
+    }
+    for (auto &reader : readers)
+    {
+        reader.join();
+    }
+    EXPECT_EQ(sum, 4 * 64);
+    EXPECT_EQ(*FLAGS_queue_name, "jobs");
+    EXPECT_EQ(*FLAGS_flush_time, std::chrono::seconds{2});
+    EXPECT_EQ(ArgParser::flags().retrieve<int>("b"), 64);
+    EXPECT_FALSE(ArgParser::flags().needHelp());
+
+    static ArgFlag<int> late{"-l", "--late", "registered after parsing", 5};
+    EXPECT_EQ(*late, 5);
+    EXPECT_EQ(ArgParser::flags().retrieve("late"), std::nullopt); // not added to flags()
+    EXPECT_EXCEPTION(ArgParser::parseFlags(3, argv), std::runtime_error, "Flags can only be parsed once");
+}
+
+TEST_F(ArgParserTest, OverlayTest)
+{
+    ArgParser base{};
+    base.addArgumentWithDefault("-w", "--waitTime", "wait time", 10)
+        .addArgument("-l", "--logfile", "log file")
+        .addArgument("-i", "--ids", "ids")
+        .addChoiceArgumentWithDefault("-m", "--mode", "run mode",
+                                      std::vector<std::pair<std::string, Mode>>{{"fast", Mode::Fast},
+                                                                                {"safe", Mode::Safe}},
+                                      "fast");
+    EXPECT_EXCEPTION(ArgOverlay{base}, std::runtime_error,
+                     "parse() must be called with command line arguments before retrieving values");
+
+    std::string logArg{"--logfile=base.log"};
+    char *argv[] = {binaryPath.data(), logArg.data()};
+    base.parse(2, argv);
+
+    ArgOverlay tenant{base};
+    ArgOverlay other{base};
+    tenant.set("waitTime", 20).set("l", "tenant.log").set("ids", "1,2").set("mode", "safe");
+    EXPECT_EQ(tenant.size(), 4);
+    EXPECT_EQ(tenant.retrieve<int>("waitTime"), 20);
+    EXPECT_EQ(tenant.retrieve("logfile"), "tenant.log"); // over a passed value as well
+    EXPECT_EQ(tenant.retrieve<std::vector<int>>("i"), (std::vector<int>{1, 2}));
+    EXPECT_EQ(tenant.retrieve<Mode>("mode"), Mode::Safe);
+    EXPECT_EQ(tenant.retrieve(base.optOf<int>("w")), 20);
+    EXPECT_EQ(tenant.retrieve<int>("unknown"), std::nullopt);
+    ArgParser larger{base};
+    EXPECT_EQ(tenant.retrieve(larger.addTypedArgument("-x", "--extra", "extra")), std::nullopt);
+
+    // the base and other overlays are not affected
+    EXPECT_EQ(base.retrieve<int>("waitTime"), 10);
+    EXPECT_EQ(other.retrieve<int>("waitTime"), 10);
+    EXPECT_EQ(other.retrieve("logfile"), "base.log");
+    EXPECT_EQ(other.retrieve<Mode>("mode"), Mode::Fast);
+    EXPECT_EQ(other.retrieve("ids"), std::nullopt);
+    EXPECT_EQ(other.size(), 0);
+
+    tenant.set("waitTime", 30).reset("logfile");
+    EXPECT_EQ(tenant.retrieveMayThrow<int>("w"), 30);
+    EXPECT_EQ(tenant.retrieve("logfile"), "base.log");
+    EXPECT_EQ(tenant.size(), 3);
+    EXPECT_EXCEPTION(tenant.retrieveMayThrow<int>("logfile"), std::runtime_error,
+                     "Type conversion failed for logfile");
+
+    EXPECT_EXCEPTION(tenant.set("mode", "turbo"), std::runtime_error,
+                     "Invalid value [turbo] for [-m, --mode], allowed values are: fast, safe");
+    EXPECT_EXCEPTION(tenant.set("unknown", 1), std::runtime_error, "Unknown argument: unknown");
+    EXPECT_EXCEPTION(tenant.reset("unknown"), std::runtime_error, "Unknown argument: unknown");
+
+    // slots 1 and 65 share a bit of the mask
+    ArgParser wide{};
+    for (int i = 1; i <= 70; ++i)
+    {
+        wide.addArgumentWithDefault(concatenate("-a", i), concatenate("--arg", i), "arg", i);
+    }
+    wide.parse(1, argv);
+    ArgOverlay wideTenant{wide};
+    wideTenant.set("arg1", -1).set("arg65", -65);
+    EXPECT_EQ(wideTenant.retrieve<int>("arg129"), std::nullopt);
+    EXPECT_EQ(wideTenant.retrieve<int>("arg2"), 2);
+    wideTenant.reset("arg1");
+    EXPECT_EQ(wideTenant.retrieve<int>("arg1"), 1);
+    EXPECT_EQ(wideTenant.retrieve<int>("arg65"), -65);
+}
+
+TEST_F(ArgParserTest, InterpolationTest)
+{
+    ArgParser argParser{};
+    argParser.addArgumentWithDefault("-w", "--workdir", "work directory", "/tmp/${user}")
+        .addArgument("-u", "--user", "user")
+        .addArgumentWithDefault("-o", "--out", "output", "${workdir}/results")
+        .addArgumentWithDefault("-c", "--cache", "cache", "${env:ARG_PARSER_TEST_HOME}/.cache")
+        .addArgumentWithDefault("-p", "--price", "price", "$$5 or $1")
+        .addArgument("-n", "--name", "name")
+        .addArgument("-e", "--email", "email")
+        .enableInterpolation();
+
+    setenv("ARG_PARSER_TEST_HOME", "/home/test", 1);
+    parse(argParser, {"--user=ann", "--name=${u}-${e}"});
+    EXPECT_EQ(argParser.retrieve("out"), "/tmp/ann/results");
+    EXPECT_EQ(argParser.retrieve("workdir"), "/tmp/ann");
+    EXPECT_EQ(argParser.retrieve("cache"), "/home/test/.cache");
+    EXPECT_EQ(argParser.retrieve("price"), "$5 or $1");
+    setenv("ARG_PARSER_TEST_HOME", "/home/other", 1);
+    EXPECT_EQ(argParser.retrieve("cache"), "/home/test/.cache"); // kept till the next parse
+    EXPECT_EQ(argParser.canonicalConfig(), "cache=/home/test/.cache\nname=ann-\nout=/tmp/ann/results\n"
+                                           "price=$5 or $1\nuser=ann\nworkdir=/tmp/ann\n");
+
+    parse(argParser, {"-w=/data", "-o=${w}/${u}"});
+    EXPECT_EQ(argParser.retrieve("out"), "/data/"); // user has no value
+    EXPECT_EQ(argParser.retrieve("cache"), "/home/other/.cache");
+    argParser.setOverride("user", "bob");
+    EXPECT_EQ(argParser.retrieve("out"), "/data/bob");
+
+    ArgParser copy{argParser};
+    EXPECT_EQ(copy.retrieve("out"), "/data/bob");
+
+    EXPECT_EXCEPTION(parse(argParser, {"-w=${out}"}), std::runtime_error,
+                     "Cyclic interpolation: [-w, --workdir] -> [-o, --out] -> [-w, --workdir]");
+    EXPECT_EQ(argParser.retrieve("out"), std::nullopt); // nothing is retrieved from a parse which has thrown
+    EXPECT_EQ(argParser.retrieve("workdir"), std::nullopt);
+    EXPECT_FALSE(argParser.contains("workdir"));
+    EXPECT_EXCEPTION(parse(argParser, {"-n=${n}"}), std::runtime_error,
+                     "Cyclic interpolation: [-n, --name] -> [-n, --name]");
+    EXPECT_EXCEPTION(parse(argParser, {"-n=${team}"}), std::runtime_error,
+                     "Invalid value [${team}] for [-n, --name], unknown argument: team");
+    EXPECT_EXCEPTION(parse(argParser, {"-n=${user"}), std::runtime_error,
+                     "Invalid value [${user] for [-n, --name], ${ is not closed");
+
+    parse(argParser, {});
+    EXPECT_EXCEPTION(argParser.setOverride("user", "${o}"), std::runtime_error,
+                     "Cyclic interpolation: [-w, --workdir] -> [-u, --user] -> [-o, --out] -> [-w, --workdir]");
+    EXPECT_EQ(argParser.retrieve("out"), "/tmp/bob/results"); // the earlier override is kept
+
+    ArgParser overridden{};
+    overridden.addArgument("-a", "--aa", "first")
+        .addArgumentWithDefault("-b", "--bb", "second", "${aa}")
+        .setOverride("bb", "x")
+        .enableInterpolation();
+    parse(overridden, {"--aa=${bb}"});
+    EXPECT_EXCEPTION(overridden.clearOverrides(), std::runtime_error,
+                     "Cyclic interpolation: [-a, --aa] -> [-b, --bb] -> [-a, --aa]");
+    EXPECT_EQ(overridden.retrieve("aa"), "x"); // the overrides are kept
+
+    ArgParser doubling{};
+    doubling.addArgumentWithDefault("-i", "--ii", "first", "x").enableInterpolation();
+    for (char name = 'j'; name <= 'z'; ++name)
+    {
+        const std::string previous{static_cast<char>(name - 1)};
+        doubling.addArgumentWithDefault(std::string{'-', name}, std::string{"--"} + name + name, "doubles the previous",
+                                        "${" + previous + "}${" + previous + "}");
+    }
+    EXPECT_EXCEPTION(parse(doubling, {}), std::runtime_error,
+                     "Invalid value [${u}${u}] for [-v, --vv], expansions of values would be longer than 64 times "
+                     "the values");
+
+    ArgParser plain{};
+    plain.addArgumentWithDefault("-o", "--out", "output", "${workdir}");
+    parse(plain, {});
+    EXPECT_EQ(plain.retrieve("out"), "${workdir}"); // not enabled
+}
+
+TEST_F(ArgParserTest, InterpolatedOverlayTest)
+{
+    ArgParser base{};
+    base.addArgumentWithDefault("-w", "--workdir", "work directory", "/tmp/${user}")
+        .addArgumentWithDefault("-u", "--user", "user", "ann")
+        .addArgumentWithDefault("-o", "--out", "output", "${workdir}/results")
+        .addArgument("-n", "--name", "name")
+        .enableInterpolation();
+    parse(base, {});
+
+    ArgOverlay tenant{base};
+    tenant.set("user", "bob").set("name", "${user}-$$1");
+    EXPECT_EQ(tenant.retrieve("out"), "/tmp/bob/results"); // values of base expand with the values of the overlay
+    EXPECT_EQ(tenant.retrieve("workdir"), "/tmp/bob");
+    EXPECT_EQ(tenant.retrieve("name"), "bob-$1"); // and so do the set ones
+    EXPECT_EQ(base.retrieve("out"), "/tmp/ann/results");
+
+    tenant.set("workdir", "/data").set("user", "${out}");
+    EXPECT_EQ(tenant.retrieve("user"), "/data/results");
+    EXPECT_EQ(tenant.retrieve("name"), "/data/results-$1");
+    EXPECT_EXCEPTION(tenant.reset("workdir"), std::runtime_error,
+                     "Cyclic interpolation: [-w, --workdir] -> [-u, --user] -> [-o, --out] -> [-w, --workdir]");
+    EXPECT_EQ(tenant.retrieve("workdir"), "/data"); // the change is taken back
+    EXPECT_EXCEPTION(tenant.set("name", "${team}"), std::runtime_error,
+                     "Invalid value [${team}] for [-n, --name], unknown argument: team");
+    EXPECT_EQ(tenant.retrieve("name"), "/data/results-$1");
+
+    tenant.reset("user").reset("workdir");
+    EXPECT_EQ(tenant.retrieve("out"), "/tmp/ann/results");
+    EXPECT_EQ(tenant.retrieve("name"), "ann-$1");
+}
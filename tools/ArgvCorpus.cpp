@@ -0,0 +1,377 @@
+#include <argParser/ArgParser.h>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+
+// Captures real command lines into a corpus file and replays them through a schema to profile ArgParser::parse
+//
+// Capture, appends one invocation per line:
+//      argvCorpus --corpus=fleet.corpus --pids=1234,5678   // from /proc/<pid>/cmdline
+//      argvCorpus --corpus=fleet.corpus --log=launches.log // one shell command line per log line
+// Replay:
+//      argvCorpus --corpus=fleet.corpus --schema=app.schema --iterations=1000
+//
+// Corpus format: arguments of an invocation are separated by tabs, and '\', <tab>, <newline> are escaped
+// Schema format: one argument per line "-s --long [mandatory|optional|default=<value>] help message"
+//                and '#' starts a comment
+namespace
+{
+using Argv = std::vector<std::string>;
+
+std::string escape(const std::string &arg)
+{
+    std::string escaped;
+    escaped.reserve(arg.size());
+    for (const char c : arg)
+    {
+        switch (c)
+        {
+            case '\\': escaped += "\\\\"; break;
+            case '\t': escaped += "\\t"; break;
+            case '\n': escaped += "\\n"; break;
+            default: escaped += c;
+        }
+    }
+    return escaped;
+}
+
+Argv unescape(const std::string &line)
+{
+    Argv argv(1);
+    for (std::size_t i = 0; i < line.size(); ++i)
+    {
+        if (line[i] == '\t')
+        {
+            argv.emplace_back();
+        }
+        else if (line[i] == '\\' && i + 1 < line.size())
+        {
+            const char c = line[++i];
+            argv.back() += c == 't' ? '\t' : c == 'n' ? '\n' : c;
+        }
+        else
+        {
+            argv.back() += line[i];
+        }
+    }
+    return argv;
+}
+
+void writeRecord(std::ostream &corpus, const Argv &argv)
+{
+    for (std::size_t i = 0; i < argv.size(); ++i)
+    {
+        corpus << (i ? "\t" : "") << escape(argv[i]);
+    }
+    corpus << '\n';
+}
+
+// /proc/<pid>/cmdline holds the arguments, each terminated by '\0'
+std::optional<Argv> readCmdline(const std::string &pid)
+{
+    std::ifstream cmdline{"/proc/" + pid + "/cmdline", std::ios::binary};
+    if (!cmdline)
+    {
+        return std::nullopt; // process is gone
+    }
+    std::string content{std::istreambuf_iterator<char>{cmdline}, {}};
+    if (content.empty())
+    {
+        return std::nullopt; // kernel threads and zombies have no command line
+    }
+    Argv argv;
+    std::size_t begin{0};
+    for (auto end = content.find('\0'); end != std::string::npos; end = content.find('\0', begin = end + 1))
+    {
+        argv.emplace_back(content, begin, end - begin);
+    }
+    if (begin < content.size())
+    {
+        argv.emplace_back(content, begin);
+    }
+    return argv;
+}
+
+// Splits a shell command line on blanks, honoring single and double quotes and backslash escapes
+std::optional<Argv> splitCommandLine(const std::string &line)
+{
+    Argv argv;
+    bool inWord{false};
+    char quote{0};
+    for (std::size_t i = 0; i < line.size(); ++i)
+    {
+        const char c = line[i];
+        if (quote == 0 && (c == ' ' || c == '\t' || c == '\r'))
+        {
+            inWord = false;
+            continue;
+        }
+        if (!inWord)
+        {
+            argv.emplace_back();
+            inWord = true;
+        }
+        if (c == quote)
+        {
+            quote = 0;
+        }
+        else if (quote == 0 && (c == '\'' || c == '"'))
+        {
+            quote = c;
+        }
+        else if (c == '\\' && quote != '\'' && i + 1 < line.size())
+        {
+            argv.back() += line[++i];
+        }
+        else
+        {
+            argv.back() += c;
+        }
+    }
+    if (quote != 0 || argv.empty())
+    {
+        return std::nullopt;
+    }
+    return argv;
+}
+
+std::size_t capturePids(const std::string &pids, std::ostream &corpus)
+{
+    std::size_t captured{0};
+    std::istringstream pidList{pids};
+    for (std::string pid; std::getline(pidList, pid, ',');)
+    {
+        if (const auto argv = readCmdline(pid))
+        {
+            writeRecord(corpus, *argv);
+            ++captured;
+        }
+        else
+        {
+            std::cerr << "Skipping pid " << pid << ": no command line to capture\n";
+        }
+    }
+    return captured;
+}
+
+std::size_t captureLog(const std::string &logPath, std::ostream &corpus)
+{
+    std::ifstream log{logPath};
+    if (!log)
+    {
+        throw std::runtime_error("Couldn't read log file: " + logPath);
+    }
+    std::size_t captured{0}, lineNumber{0};
+    for (std::string line; std::getline(log, line);)
+    {
+        ++lineNumber;
+        if (const auto argv = splitCommandLine(line))
+        {
+            writeRecord(corpus, *argv);
+            ++captured;
+        }
+        else if (line.find_first_not_of(" \t\r") != std::string::npos)
+        {
+            std::cerr << "Skipping line " << lineNumber << " of " << logPath << ": unbalanced quotes\n";
+        }
+    }
+    return captured;
+}
+
+std::vector<Argv> loadCorpus(const std::string &corpusPath)
+{
+    std::ifstream corpus{corpusPath};
+    if (!corpus)
+    {
+        throw std::runtime_error("Couldn't read corpus file: " + corpusPath);
+    }
+    std::vector<Argv> records;
+    for (std::string line; std::getline(corpus, line);)
+    {
+        if (!line.empty())
+        {
+            records.push_back(unescape(line));
+        }
+    }
+    return records;
+}
+
+ArgParser loadSchema(const std::string &schemaPath)
+{
+    std::ifstream schema{schemaPath};
+    if (!schema)
+    {
+        throw std::runtime_error("Couldn't read schema file: " + schemaPath);
+    }
+    ArgParser argParser{"replayed schema"};
+    for (std::string line; std::getline(schema, line);)
+    {
+        std::istringstream fields{line.substr(0, line.find('#'))};
+        std::string shortOpt, longOpt, kind;
+        if (!(fields >> shortOpt))
+        {
+            continue;
+        }
+        fields >> longOpt >> kind;
+        std::string helpMsg;
+        std::getline(fields >> std::ws, helpMsg);
+        static constexpr std::string_view defaultPrefix{"default="};
+        if (kind.compare(0, defaultPrefix.size(), defaultPrefix) == 0)
+        {
+            argParser.addArgumentWithDefault(shortOpt, longOpt, helpMsg, kind.substr(defaultPrefix.size()));
+        }
+        else if (kind == "mandatory" || kind == "optional")
+        {
+            argParser.addArgument(shortOpt, longOpt, helpMsg, kind == "mandatory");
+        }
+        else
+        {
+            throw std::runtime_error(
+                "Invalid schema line, expected '-s --long [mandatory|optional|default=<value>] help': " + line);
+        }
+    }
+    return argParser;
+}
+
+// Values in error messages are bracketed or follow the first ": ", dropping them groups errors by their cause
+std::string errorCategory(const std::string &message)
+{
+    std::string category;
+    int depth{0};
+    for (const char c : message.substr(0, message.find(": ")))
+    {
+        depth += c == '[';
+        if (depth == 0)
+        {
+            category += c;
+        }
+        depth -= c == ']' && depth > 0;
+        if (c == ']' && depth == 0)
+        {
+            category += "[]";
+        }
+    }
+    return category;
+}
+
+void replay(const std::vector<Argv> &records, ArgParser &argParser, int iterations)
+{
+    using Clock = std::chrono::steady_clock;
+
+    std::vector<std::vector<char *>> argvs;
+    argvs.reserve(records.size());
+    for (const auto &record : records)
+    {
+        auto &argv = argvs.emplace_back();
+        for (const auto &arg : record)
+        {
+            argv.push_back(const_cast<char *>(arg.c_str()));
+        }
+        argv.push_back(nullptr);
+    }
+
+    std::vector<std::chrono::nanoseconds> latencies;
+    latencies.reserve(records.size() * iterations);
+    std::map<std::string, std::size_t> outcomes;
+    const auto start = Clock::now();
+    for (int iteration = 0; iteration < iterations; ++iteration)
+    {
+        for (auto &argv : argvs)
+        {
+            std::string outcome{"ok"};
+            const auto parseStart = Clock::now();
+            try
+            {
+                argParser.parse(static_cast<int>(argv.size() - 1), argv.data());
+            }
+            catch (const std::exception &e)
+            {
+                outcome = e.what();
+            }
+            latencies.push_back(Clock::now() - parseStart);
+            if (iteration == 0)
+            {
+                ++outcomes[outcome == "ok" && argParser.needHelp() ? "help" : errorCategory(outcome)];
+            }
+        }
+    }
+    const std::chrono::duration<double> elapsed = Clock::now() - start;
+
+    std::sort(latencies.begin(), latencies.end());
+    const auto percentile = [&latencies](double p)
+    {
+        return latencies[static_cast<std::size_t>(p * static_cast<double>(latencies.size() - 1))].count();
+    };
+    std::cout << "invocations: " << records.size() << ", iterations: " << iterations << ", parses: "
+              << latencies.size() << "\n"
+              << "throughput: " << static_cast<std::size_t>(static_cast<double>(latencies.size()) / elapsed.count())
+              << " parses/s\n"
+              << "latency ns: p50 " << percentile(0.5) << ", p90 " << percentile(0.9) << ", p99 "
+              << percentile(0.99) << ", p99.9 " << percentile(0.999) << ", max " << latencies.back().count()
+              << "\n"
+              << "outcomes per invocation:\n";
+    for (const auto &[outcome, count] : outcomes)
+    {
+        std::cout << "  " << count << "\t" << outcome << "\n";
+    }
+}
+}
+
+int main(int argc, char *argv[])
+{
+    ArgParser argParser{"Captures command lines into a corpus and replays it through a schema"};
+    argParser.addArgument("-c", "--corpus", "corpus file, captured invocations are appended to it", true)
+        .addArgument("-p", "--pids", "comma separated pids to capture from /proc/<pid>/cmdline")
+        .addArgument("-l", "--log", "log file to capture, one shell command line per line")
+        .addArgument("-s", "--schema", "schema file to replay the corpus through")
+        .addArgumentWithDefault("-i", "--iterations", "how many times to replay the corpus", 1000)
+        .addAtLeastOne({"pids", "log", "schema"});
+
+    try
+    {
+        argParser.parse(argc, argv);
+        if (argParser.needHelp())
+        {
+            std::cout << argParser.helpMsg();
+            return 0;
+        }
+
+        const auto corpusPath = *argParser.retrieve("corpus");
+        const auto pids = argParser.retrieve("pids");
+        const auto logPath = argParser.retrieve("log");
+        if (pids || logPath)
+        {
+            std::ofstream corpus{corpusPath, std::ios::app};
+            if (!corpus)
+            {
+                throw std::runtime_error("Couldn't open corpus file: " + corpusPath);
+            }
+            const auto captured = (pids ? capturePids(*pids, corpus) : 0)
+                                  + (logPath ? captureLog(*logPath, corpus) : 0);
+            std::cout << "captured " << captured << " invocations into " << corpusPath << "\n";
+        }
+
+        if (const auto schemaPath = argParser.retrieve("schema"))
+        {
+            const auto iterations = argParser.retrieve<int>("iterations");
+            if (!iterations || *iterations <= 0)
+            {
+                throw std::runtime_error("Iterations must be a positive number");
+            }
+            auto schema = loadSchema(*schemaPath);
+            const auto records = loadCorpus(corpusPath);
+            if (records.empty())
+            {
+                throw std::runtime_error("Corpus is empty: " + corpusPath);
+            }
+            replay(records, schema, *iterations);
+        }
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+}
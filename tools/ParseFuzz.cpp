@@ -0,0 +1,495 @@
+#include <argParser/ArgParser.h>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <new>
+#include <random>
+
+// Stress tests ArgParser with generated adversarial command lines and schemas, without an external fuzzing engine,
+// and checks that parse() and helpMsg() take time and allocate memory in proportion to their input
+//
+//      parseFuzz --seed=7 --rounds=20 --size=32KiB
+//
+// Every round generates an input of each shape at --size and at 32 times --size, e.g. a megabyte long option name,
+// options followed by a repeated or unknown one, values full of '=', huge schemas, and values which reference each
+// other
+// Bounds, where units of an input are its bytes plus a fixed cost for each argument and for the parser:
+//  - time per unit of the larger input is at most 8 times of the smaller one, so the cost grows linearly, a
+//    quadratic one would be 32 times, while caches and the allocator switching to mmap make up a few times
+//  - allocated bytes and the number of allocations are at most a constant times the units
+// An input which breaks a bound is minimized, by dropping arguments and halving strings while it still breaks the
+// bound, and is printed with the bound it breaks, the exit code is 1 then
+namespace
+{
+std::size_t allocatedBytes{0};
+std::size_t allocations{0};
+}
+
+void *operator new(std::size_t size)
+{
+    allocatedBytes += size;
+    ++allocations;
+    if (void *memory = std::malloc(size))
+    {
+        return memory;
+    }
+    throw std::bad_alloc{};
+}
+
+void operator delete(void *memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void *memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+namespace
+{
+constexpr std::size_t unitsPerArgument{16};
+constexpr std::size_t unitsPerParser{1024};
+constexpr std::size_t largeInputFactor{32};
+constexpr double maxTimeGrowth{8.0};
+constexpr std::size_t maxBytesPerUnit{128};
+constexpr std::size_t maxAllocationsPerUnit{1};
+constexpr int maxMinimizeSteps{2000};
+
+struct Input
+{
+    std::vector<ArgParser::ArgSpec> schema{};
+    std::vector<std::string> argv{}; // without the app path
+    bool interpolation{false};
+};
+
+struct Cost
+{
+    double nanos{0};
+    std::size_t bytes{0};
+    std::size_t allocations{0};
+};
+
+std::size_t unitsOf(const Input &input)
+{
+    std::size_t units{unitsPerParser + (input.schema.size() + input.argv.size()) * unitsPerArgument};
+    for (const auto &spec : input.schema)
+    {
+        units += spec.shortOpt.size() + spec.longOpt.size() + spec.helpMsg.size() +
+                 (spec.defaultValue ? spec.defaultValue->size() : 0);
+    }
+    for (const auto &arg : input.argv)
+    {
+        units += arg.size();
+    }
+    return units;
+}
+
+// Configures, parses, retrieves every value and builds the help message, failures are fine but must be as cheap
+void run(const Input &input, std::vector<char *> &argv)
+{
+    ArgParser argParser{"parse fuzz"};
+    try
+    {
+        argParser.addArguments(input.schema);
+        if (input.interpolation)
+        {
+            argParser.enableInterpolation();
+        }
+        argParser.parse(static_cast<int>(argv.size() - 1), argv.data());
+        if (!argParser.needHelp())
+        {
+            for (const auto &spec : input.schema)
+            {
+                argParser.retrieve(spec.longOpt.substr(2));
+            }
+        }
+    }
+    catch (const std::exception &)
+    {
+    }
+    volatile auto helpSize = argParser.helpMsg().size();
+    static_cast<void>(helpSize);
+}
+
+// the fastest of a few runs for time, as the others were slowed down by something else
+Cost measure(const Input &input)
+{
+    using Clock = std::chrono::steady_clock;
+    std::string appPath{"app"};
+    std::vector<std::string> args{input.argv};
+    std::vector<char *> argv{appPath.data()};
+    for (auto &arg : args)
+    {
+        argv.push_back(arg.data());
+    }
+    argv.push_back(nullptr);
+
+    Cost cost{};
+    for (int repeat = 0; repeat < 3; ++repeat)
+    {
+        const auto bytes = allocatedBytes;
+        const auto count = allocations;
+        const auto start = Clock::now();
+        run(input, argv);
+        const std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+        cost.nanos = repeat == 0 ? elapsed.count() : std::min(cost.nanos, elapsed.count());
+        cost.bytes = allocatedBytes - bytes;
+        cost.allocations = allocations - count;
+    }
+    return cost;
+}
+
+enum class Bound
+{
+    None,
+    Bytes,
+    Allocations,
+    Time
+};
+
+struct Violation
+{
+    Bound bound{Bound::None};
+    std::string message{};
+};
+
+// The bound which @cost of @input breaks
+// @nanosPerUnit is of an input of the same shape but @largeInputFactor times smaller, 0 to not check time
+Violation check(const Input &input, const Cost &cost, double nanosPerUnit)
+{
+    const auto units = unitsOf(input);
+    if (cost.bytes > maxBytesPerUnit * units)
+    {
+        return {Bound::Bytes, "allocated " + std::to_string(cost.bytes) + " bytes for " + std::to_string(units) +
+                              " units"};
+    }
+    if (cost.allocations > maxAllocationsPerUnit * units)
+    {
+        return {Bound::Allocations, std::to_string(cost.allocations) + " allocations for " + std::to_string(units) +
+                                    " units"};
+    }
+    const auto growth = cost.nanos / static_cast<double>(units) / nanosPerUnit;
+    if (nanosPerUnit > 0 && growth > maxTimeGrowth)
+    {
+        return {Bound::Time, "time per unit is " + std::to_string(growth) + " times of a " +
+                             std::to_string(largeInputFactor) + " times smaller input"};
+    }
+    return {};
+}
+
+// Drops arguments and halves strings while @violation.bound is still broken, and updates @violation
+// Only the same bound counts, so that it doesn't end up with another input which happened to be slow once
+Input minimize(Input input, double nanosPerUnit, Violation &violation)
+{
+    int steps{0};
+    const auto breaks = [&steps, nanosPerUnit, &violation](const Input &candidate)
+    {
+        ++steps;
+        auto candidateViolation = check(candidate, measure(candidate), nanosPerUnit);
+        if (candidateViolation.bound != violation.bound)
+        {
+            return false;
+        }
+        violation = std::move(candidateViolation);
+        return true;
+    };
+    const auto dropChunks = [&](auto member)
+    {
+        bool dropped{false};
+        for (auto chunk = (input.*member).size() / 2; chunk > 0 && steps < maxMinimizeSteps; chunk /= 2)
+        {
+            for (std::size_t start = 0; start < (input.*member).size() && steps < maxMinimizeSteps;)
+            {
+                auto candidate = input;
+                auto &elements = candidate.*member;
+                const auto end = std::min(start + chunk, elements.size());
+                elements.erase(elements.begin() + static_cast<std::ptrdiff_t>(start),
+                               elements.begin() + static_cast<std::ptrdiff_t>(end));
+                if (breaks(candidate))
+                {
+                    input = std::move(candidate);
+                    dropped = true;
+                }
+                else
+                {
+                    start += chunk;
+                }
+            }
+        }
+        return dropped;
+    };
+    const auto halve = [&](std::string &str)
+    {
+        bool halved{false};
+        while (str.size() > 8 && steps < maxMinimizeSteps)
+        {
+            const auto original = str;
+            str.resize(str.size() / 2);
+            if (!breaks(input))
+            {
+                str = original;
+                break;
+            }
+            halved = true;
+        }
+        return halved;
+    };
+
+    for (bool shrunk = true; shrunk && steps < maxMinimizeSteps;)
+    {
+        shrunk = dropChunks(&Input::argv);
+        shrunk = dropChunks(&Input::schema) || shrunk;
+        for (auto &arg : input.argv)
+        {
+            shrunk = halve(arg) || shrunk;
+        }
+        for (auto &spec : input.schema)
+        {
+            shrunk = halve(spec.longOpt) || shrunk;
+            shrunk = halve(spec.helpMsg) || shrunk;
+            if (spec.defaultValue)
+            {
+                shrunk = halve(*spec.defaultValue) || shrunk;
+            }
+        }
+    }
+    return input;
+}
+
+std::string abbreviate(const std::string &str)
+{
+    static constexpr std::size_t maxShown{64};
+    if (str.size() <= maxShown)
+    {
+        return '"' + str + '"';
+    }
+    return '"' + str.substr(0, maxShown / 2) + "\"...(" + std::to_string(str.size()) + " chars)";
+}
+
+void print(const Input &input)
+{
+    std::cout << "  schema, " << input.schema.size() << " arguments"
+              << (input.interpolation ? ", interpolation enabled" : "") << ":\n";
+    for (const auto &spec : input.schema)
+    {
+        std::cout << "    " << abbreviate(spec.shortOpt) << " " << abbreviate(spec.longOpt) << " "
+                  << abbreviate(spec.helpMsg) << (spec.isMandatory ? " mandatory" : "")
+                  << (spec.defaultValue ? " default=" + abbreviate(*spec.defaultValue) : "") << "\n";
+    }
+    std::cout << "  argv, " << input.argv.size() << " arguments:\n";
+    for (const auto &arg : input.argv)
+    {
+        std::cout << "    " << abbreviate(arg) << "\n";
+    }
+}
+
+std::string randomName(std::mt19937_64 &random, std::size_t size)
+{
+    static constexpr std::string_view chars{"abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789_"};
+    std::string name(size, 'a');
+    for (auto &c : name)
+    {
+        c = chars[random() % chars.size()];
+    }
+    return name;
+}
+
+// a schema of @count arguments, "-s<i>" and "--long_<i>"
+std::vector<ArgParser::ArgSpec> manyArguments(std::mt19937_64 &random, std::size_t count)
+{
+    std::vector<ArgParser::ArgSpec> schema{};
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        auto &spec = schema.emplace_back();
+        spec.shortOpt = "-s" + std::to_string(i);
+        spec.longOpt = "--long_" + std::to_string(i);
+        spec.helpMsg = randomName(random, 16);
+        if (random() % 2 == 0)
+        {
+            spec.defaultValue = std::to_string(i);
+        }
+    }
+    return schema;
+}
+
+using Shape = std::function<Input(std::mt19937_64 &random, std::size_t size)>;
+
+std::vector<std::pair<std::string, Shape>> shapes()
+{
+    const ArgParser::ArgSpec alpha{"-a", "--alpha", "alpha"};
+    return {
+        {"long unknown option", [alpha](std::mt19937_64 &random, std::size_t size)
+        {
+            const auto dashes = random() % 2 == 0 ? "-" : "--";
+            return Input{{alpha}, {dashes + randomName(random, size) + "=v"}};
+        }},
+        {"long configured option", [](std::mt19937_64 &random, std::size_t size)
+        {
+            const auto name = randomName(random, size);
+            return Input{{{"-a", "--" + name, "long"}}, {"--" + name + "=v", "-a=w"}};
+        }},
+        {"long value", [alpha](std::mt19937_64 &random, std::size_t size)
+        {
+            return Input{{alpha}, {"--alpha=" + randomName(random, size)}};
+        }},
+        {"many '='", [alpha](std::mt19937_64 &random, std::size_t size)
+        {
+            static const std::vector<std::string> prefixes{"--alpha=", "--alpha", "--", "-", "="};
+            return Input{{alpha}, {prefixes[random() % prefixes.size()] + std::string(size, '=')}};
+        }},
+        // parse() stops at the first repeated or unknown option, so these come after many distinct ones, and the
+        // whole command line is scanned before the error
+        {"options then a repeated one", [](std::mt19937_64 &random, std::size_t size)
+        {
+            Input input{manyArguments(random, size / 32)};
+            for (const auto &spec : input.schema)
+            {
+                input.argv.push_back((random() % 2 == 0 ? spec.shortOpt : spec.longOpt) + "=" + randomName(random, 4));
+            }
+            std::shuffle(input.argv.begin(), input.argv.end(), random);
+            input.argv.push_back(input.argv[random() % input.argv.size()]);
+            return input;
+        }},
+        {"options then repeated unknown ones", [](std::mt19937_64 &random, std::size_t size)
+        {
+            Input input{manyArguments(random, size / 32)};
+            for (const auto &spec : input.schema)
+            {
+                input.argv.push_back((random() % 2 == 0 ? spec.shortOpt : spec.longOpt) + "=" + randomName(random, 4));
+            }
+            std::shuffle(input.argv.begin(), input.argv.end(), random);
+            const auto unknown = "--unknown_" + randomName(random, 8) + "=1";
+            input.argv.insert(input.argv.end(), 1 + random() % 64, unknown);
+            return input;
+        }},
+        {"many options", [](std::mt19937_64 &random, std::size_t size)
+        {
+            Input input{manyArguments(random, size / 32)};
+            for (const auto &spec : input.schema)
+            {
+                input.argv.push_back((random() % 2 == 0 ? spec.shortOpt : spec.longOpt) + "=" + randomName(random, 4));
+            }
+            std::shuffle(input.argv.begin(), input.argv.end(), random);
+            return input;
+        }},
+        {"huge schema for help", [](std::mt19937_64 &random, std::size_t size)
+        {
+            return Input{manyArguments(random, size / 32), {random() % 2 == 0 ? "--help" : "-h"}};
+        }},
+        {"huge schema of mandatory arguments", [](std::mt19937_64 &random, std::size_t size)
+        {
+            Input input{manyArguments(random, size / 32)};
+            for (auto &spec : input.schema)
+            {
+                spec.isMandatory = !spec.defaultValue;
+            }
+            return input;
+        }},
+        {"random tokens", [alpha](std::mt19937_64 &random, std::size_t size)
+        {
+            static constexpr std::string_view chars{"--==aaab_1,${}"};
+            Input input{{alpha, {"-b", "--beta", "beta", "${alpha}"}}, {}, true};
+            for (std::size_t total = 0; total < size;)
+            {
+                auto &arg = input.argv.emplace_back(1 + random() % 32, '-');
+                for (auto &c : arg)
+                {
+                    c = chars[random() % chars.size()];
+                }
+                total += arg.size();
+            }
+            return input;
+        }},
+        {"references", [](std::mt19937_64 &random, std::size_t size)
+        {
+            // each value references the next one, once or twice, so that expansions grow fast
+            Input input{manyArguments(random, size / 32), {}, true};
+            for (std::size_t i = 0; i + 1 < input.schema.size(); ++i)
+            {
+                const auto next = "${long_" + std::to_string(i + 1) + "}";
+                input.schema[i].defaultValue = random() % 2 == 0 ? next + next : next + "/x";
+            }
+            return input;
+        }},
+    };
+}
+}
+
+int main(int argc, char *argv[])
+{
+    ArgParser argParser{"Stress tests ArgParser with adversarial inputs, and checks bounds of time and memory"};
+    argParser.addArgumentWithDefault("-s", "--seed", "seed of random inputs", 1)
+        .addArgumentWithDefault("-r", "--rounds", "rounds of inputs of every shape", 20)
+        .addArgumentWithDefault("-z", "--size", "size of the smaller input of a round, the larger one is 32 times",
+                                ArgParser::ByteSize{8 << 10});
+
+    try
+    {
+        argParser.parse(argc, argv);
+        if (argParser.needHelp())
+        {
+            std::cout << argParser.helpMsg();
+            return 0;
+        }
+        const auto seed = argParser.retrieve<std::uint64_t>("seed");
+        const auto rounds = argParser.retrieve<int>("rounds");
+        const auto size = argParser.retrieve<ArgParser::ByteSize>("size");
+        if (!seed || !rounds || *rounds <= 0 || !size || size->bytes == 0)
+        {
+            throw std::runtime_error("Seed must be a number, and rounds and size must be positive");
+        }
+
+        std::mt19937_64 random{*seed};
+        int violations{0};
+        for (const auto &[name, shape] : shapes())
+        {
+            double worstGrowth{0};
+            std::size_t worstBytes{0}, worstAllocations{0};
+            for (int round = 0; round < *rounds; ++round)
+            {
+                const auto roundSeed = random();
+                std::mt19937_64 smallRandom{roundSeed}, largeRandom{roundSeed};
+                const auto small = shape(smallRandom, size->bytes);
+                const auto large = shape(largeRandom, size->bytes * largeInputFactor);
+                const auto smallCost = measure(small);
+                const auto nanosPerUnit = smallCost.nanos / static_cast<double>(unitsOf(small));
+
+                for (const auto *input : {&small, &large})
+                {
+                    const auto cost = input == &small ? smallCost : measure(*input);
+                    const auto units = unitsOf(*input);
+                    worstGrowth = std::max(worstGrowth, cost.nanos / static_cast<double>(units) / nanosPerUnit);
+                    worstBytes = std::max(worstBytes, cost.bytes / units);
+                    worstAllocations = std::max(worstAllocations, cost.allocations * 100 / units);
+
+                    const auto reference = input == &large ? nanosPerUnit : 0;
+                    auto violation = check(*input, cost, reference);
+                    if (violation.bound != Bound::None)
+                    {
+                        ++violations;
+                        std::cout << "[" << name << "] round " << round << ": " << violation.message << "\n";
+                        const auto minimized = minimize(*input, reference, violation);
+                        std::cout << "  minimized, " << violation.message << ":\n";
+                        print(minimized);
+                        break;
+                    }
+                }
+            }
+            std::cout << name << ": time growth " << worstGrowth << ", bytes per unit " << worstBytes
+                      << ", allocations per 100 units " << worstAllocations << "\n";
+        }
+        if (violations > 0)
+        {
+            std::cout << violations << " inputs broke the bounds\n";
+            return 1;
+        }
+        std::cout << "all inputs are within the bounds\n";
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+}